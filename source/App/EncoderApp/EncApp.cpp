@@ -41,9 +41,19 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <iomanip>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ENC_APP_SEGMENT_PARALLEL 1
+#include <unistd.h>
+#include <sys/wait.h>
+#else
+#define ENC_APP_SEGMENT_PARALLEL 0
+#endif
 
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
+#include "Utilities/Parcat.h"
 
 using namespace std;
 
@@ -475,6 +485,7 @@ Void EncApp::xInitLibCfg()
   m_cEncLib.setKeepHierBit                                       ( m_RCKeepHierarchicalBit );
   m_cEncLib.setLCULevelRC                                        ( m_RCLCULevelRC );
   m_cEncLib.setUseLCUSeparateModel                               ( m_RCUseLCUSeparateModel );
+  m_cEncLib.setLCULookaheadRC                                    ( m_RCLCULookahead );
   m_cEncLib.setInitialQP                                         ( m_RCInitialQP );
   m_cEncLib.setForceIntraQP                                      ( m_RCForceIntraQP );
 #if U0132_TARGET_BITS_SATURATION
@@ -606,6 +617,12 @@ Void EncApp::xInitLib(Bool isFieldCoding)
  */
 Void EncApp::encode()
 {
+  if( m_segmentLength > 0 )
+  {
+    xEncodeSegments();
+    return;
+  }
+
   m_bitstream.open(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
   if (!m_bitstream)
   {
@@ -702,6 +719,180 @@ Void EncApp::encode()
   return;
 }
 
+/**
+  Segment-parallel encoding: the sequence is split at CRA pictures into segments of m_segmentLength frames, which
+  are encoded concurrently and concatenated like parcat does. Each segment also codes the first frame of the
+  following segment, which the following segment codes as IDR picture and which is dropped when concatenating.
+  The encoder library keeps process wide state, so every segment is encoded by a separate worker process.
+ */
+Void EncApp::xEncodeSegments()
+{
+#if ENC_APP_SEGMENT_PARALLEL
+  // the segments are laid out from the configured frame count, "all frames" (0) is rejected by xCheckParameter
+  const Int numFrames = m_framesToBeEncoded;
+  CHECK( numFrames <= 0, "Segment-parallel encoding requires the number of frames to be encoded" );
+
+  std::vector<Int> segStart;
+  for( Int start = 0; start == 0 || start < numFrames - 1; start += m_segmentLength )
+  {
+    segStart.push_back( start );
+  }
+
+  const Int numSegments = (Int) segStart.size();
+  const Int numJobs     = std::min( numSegments, m_segmentJobs > 0 ? m_segmentJobs : std::max<Int>( 1, std::thread::hardware_concurrency() ) );
+
+  std::vector<std::string> segBitstream( numSegments );
+  std::vector<std::string> segRecon    ( numSegments );
+  std::vector<std::string> segLog      ( numSegments );
+  std::vector<Int>         segFrames   ( numSegments );
+  std::vector<pid_t>       segPid      ( numSegments, -1 );
+
+  for( Int k = 0; k < numSegments; k++ )
+  {
+    const std::string suffix = ".seg" + std::to_string( k );
+    segBitstream[k] = m_bitstreamFileName + suffix;
+    segRecon    [k] = m_reconFileName.empty() ? std::string() : m_reconFileName + suffix;
+    segLog      [k] = m_bitstreamFileName + suffix + ".log";
+    segFrames   [k] = std::min( m_segmentLength + 1, numFrames - segStart[k] );
+  }
+
+  msg( INFO, "\nSegment-parallel encoding: %d segment(s) of %d frames, %d job(s)\n", numSegments, m_segmentLength, numJobs );
+
+  Int  nextSeg = 0;
+  Int  running = 0;
+  Bool failed  = false;
+
+  while( ( !failed && nextSeg < numSegments ) || running > 0 )
+  {
+    if( !failed && nextSeg < numSegments && running < numJobs )
+    {
+      const Int k = nextSeg++;
+
+      fflush( stdout );
+      fflush( stderr );
+      const pid_t pid = fork();
+
+      if( pid == 0 )
+      {
+        // worker process: encode the frames of segment k into its own bitstream
+        Int ret = 0;
+        m_segmentLength     = 0;
+        m_FrameSkip        += segStart[k] * m_temporalSubsampleRatio;
+        m_framesToBeEncoded = segFrames[k];
+        m_bitstreamFileName = segBitstream[k];
+        m_reconFileName     = segRecon[k];
+
+        if( freopen( segLog[k].c_str(), "w", stdout ) == NULL )
+        {
+          std::cerr << "failed to open log file " << segLog[k] << std::endl;
+          _exit( 1 );
+        }
+        try
+        {
+          encode();
+        }
+        catch( Exception &e )
+        {
+          std::cerr << e.what() << std::endl;
+          ret = 1;
+        }
+        catch( ... )
+        {
+          std::cerr << "Unspecified error occurred" << std::endl;
+          ret = 1;
+        }
+        fflush( stdout );
+        _exit( ret );
+      }
+
+      if( pid < 0 )
+      {
+        msg( ERROR, "failed to start the encoder process for segment %d\n", k );
+        failed = true;
+        continue;
+      }
+      segPid[k] = pid;
+      running++;
+      continue;
+    }
+
+    Int status = 0;
+    const pid_t pid = waitpid( -1, &status, 0 );
+    if( pid < 0 )
+    {
+      break;
+    }
+    running--;
+
+    if( !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 )
+    {
+      const Int k = Int( std::find( segPid.begin(), segPid.end(), pid ) - segPid.begin() );
+      msg( ERROR, "encoding of segment %d failed\n", k );
+      failed = true;
+    }
+  }
+
+  // report the segment logs in order
+  for( Int k = 0; k < nextSeg; k++ )
+  {
+    std::ifstream log( segLog[k].c_str() );
+    msg( INFO, "\n==== Segment %d: frames %d - %d ====\n", k, segStart[k], segStart[k] + segFrames[k] - 1 );
+    fflush( stdout );
+    if( log.good() )
+    {
+      std::cout << log.rdbuf();
+    }
+    std::cout.flush();
+    log.close();
+    remove( segLog[k].c_str() );
+  }
+
+  if( !failed )
+  {
+    failed = !parcat::concatenate( segBitstream, m_bitstreamFileName );
+  }
+
+  if( !failed && !m_reconFileName.empty() )
+  {
+    // the first frame of every segment but the first one duplicates the last frame of the preceding segment
+    std::ofstream recon( m_reconFileName.c_str(), std::ios::binary | std::ios::out );
+    for( Int k = 0; k < numSegments && recon.good(); k++ )
+    {
+      std::ifstream segRec( segRecon[k].c_str(), std::ios::binary | std::ios::in );
+      segRec.seekg( 0, std::ios::end );
+      const std::streamoff frameBytes = segRec.tellg() / segFrames[k];
+      segRec.seekg( k > 0 ? frameBytes : 0, std::ios::beg );
+      recon << segRec.rdbuf();
+    }
+    failed = !recon.good();
+  }
+
+  for( Int k = 0; k < numSegments; k++ )
+  {
+    remove( segBitstream[k].c_str() );
+    if( !segRecon[k].empty() )
+    {
+      remove( segRecon[k].c_str() );
+    }
+  }
+
+  if( failed )
+  {
+    EXIT( "segment-parallel encoding failed" );
+  }
+
+  std::ifstream bitstream( m_bitstreamFileName.c_str(), std::ios::binary | std::ios::ate );
+  m_totalBytes = UInt( bitstream.tellg() );
+  m_iFrameRcvd = numFrames;
+  msg( INFO, "\n" );
+  printRateSummary();
+#else
+  msg( WARNING, "Segment-parallel encoding is not supported on this platform, encoding sequentially\n" );
+  m_segmentLength = 0;
+  encode();
+#endif
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
@@ -73,6 +73,7 @@ private:
   Void xInitLibCfg ();                           ///< initialize internal variables
   Void xInitLib    (Bool isFieldCoding);         ///< initialize encoder class
   Void xDestroyLib ();                           ///< destroy encoder class
+  Void xEncodeSegments();                        ///< encode the sequence as concurrently encoded segments
 
   // file I/O
   Void xWriteOutput     ( Int iNumEncoded, std::list<PelUnitBuf*>& recBufList
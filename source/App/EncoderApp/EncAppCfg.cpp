@@ -760,6 +760,8 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
   ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
+  ("SegmentLength",                                   m_segmentLength,                                      0, "Number of frames per segment for segment-parallel encoding, multiple of IntraPeriod (0: disabled)")
+  ("SegmentJobs",                                     m_segmentJobs,                                        0, "Number of segments encoded concurrently (0: number of cores)")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
@@ -1092,6 +1094,7 @@ Bool EncAppCfg::parseCfg( Int argc, TChar* argv[] )
   ( "KeepHierarchicalBit",                            m_RCKeepHierarchicalBit,                              0, "Rate control: 0: equal bit allocation; 1: fixed ratio bit allocation; 2: adaptive ratio bit allocation" )
   ( "LCULevelRateControl",                            m_RCLCULevelRC,                                    true, "Rate control: true: CTU level RC; false: picture level RC" )
   ( "RCLCUSeparateModel",                             m_RCUseLCUSeparateModel,                           true, "Rate control: use CTU level separate R-lambda model" )
+  ( "RCLCULookahead",                                 m_RCLCULookahead,                                 false, "Rate control: allocate CTU target bits ahead from a pre-encode complexity analysis and update the CTU models once per picture" )
   ( "InitialQP",                                      m_RCInitialQP,                                        0, "Rate control: initial QP" )
   ( "RCForceIntraQP",                                 m_RCForceIntraQP,                                 false, "Rate control: force intra QP to be equal to initial QP" )
 #if U0132_TARGET_BITS_SATURATION
@@ -2195,6 +2198,18 @@ Bool EncAppCfg::xCheckParameter()
   {
     xConfirmPara( !m_recoveryPointSEIEnabled,                                               "When using RecoveryPointSEI messages as RA points, recoveryPointSEI must be enabled" );
   }
+  xConfirmPara( m_segmentLength < 0 || m_segmentJobs < 0,                                   "SegmentLength and SegmentJobs must not be negative" );
+  if( m_segmentLength > 0 )
+  {
+    xConfirmPara( m_iIntraPeriod <= 0 || m_segmentLength % m_iIntraPeriod != 0,             "SegmentLength must be a multiple of IntraPeriod" );
+    xConfirmPara( m_iDecodingRefreshType != 1,                                              "Segment-parallel encoding requires CRA random access points (DecodingRefreshType=1)" );
+    xConfirmPara( m_isField,                                                                "Segment-parallel encoding does not support field coding" );
+    // the merge rewrites the 8 bit POC LSBs of a single slice per picture
+    xConfirmPara( m_sliceMode != NO_SLICES,                                                 "Segment-parallel encoding requires a single slice per picture (SliceMode=0)" );
+#if HEVC_DEPENDENT_SLICES
+    xConfirmPara( m_sliceSegmentMode != NO_SLICES,                                          "Segment-parallel encoding requires a single slice segment per picture (SliceSegmentMode=0)" );
+#endif
+  }
 
   if (m_isField)
   {
@@ -2899,6 +2914,10 @@ Bool EncAppCfg::xCheckParameter()
       }
     }
     xConfirmPara( m_uiDeltaQpRD > 0, "Rate control cannot be used together with slice level multiple-QP optimization!\n" );
+    xConfirmPara( m_RCLCULookahead && !m_RCLCULevelRC, "Rate control: lookahead CTU bit allocation requires CTU level rate control" );
+#if ENABLE_WPP_PARALLELISM
+    xConfirmPara( m_RCLCULevelRC && !m_RCLCULookahead && m_numWppThreads > 1, "Rate control: CTU level rate control with WPP-style parallelism requires RCLCULookahead" );
+#endif
 #if U0132_TARGET_BITS_SATURATION
     if ((m_RCCpbSaturationEnabled) && (m_level!=Level::NONE) && (m_profile!=Profile::NONE))
     {
@@ -3008,6 +3027,10 @@ Void EncAppCfg::xPrintParameter()
     msg( DETAILS, "Frame/Field                            : Frame based coding\n" );
     msg( DETAILS, "Frame index                            : %u - %d (%d frames)\n", m_FrameSkip, m_FrameSkip + m_framesToBeEncoded - 1, m_framesToBeEncoded );
   }
+  if( m_segmentLength > 0 )
+  {
+    msg( DETAILS, "Segment-parallel encoding              : %d frames per segment, %d jobs\n", m_segmentLength, m_segmentJobs );
+  }
   if (m_profile == Profile::MAINREXT)
   {
     ExtendedProfileName validProfileName;
@@ -3103,6 +3126,7 @@ Void EncAppCfg::xPrintParameter()
     msg( DETAILS, "KeepHierarchicalBit                    : %d\n", m_RCKeepHierarchicalBit );
     msg( DETAILS, "LCULevelRC                             : %d\n", m_RCLCULevelRC );
     msg( DETAILS, "UseLCUSeparateModel                    : %d\n", m_RCUseLCUSeparateModel );
+    msg( DETAILS, "LCULookahead                           : %d\n", m_RCLCULookahead );
     msg( DETAILS, "InitialQP                              : %d\n", m_RCInitialQP );
     msg( DETAILS, "ForceIntraQP                           : %d\n", m_RCForceIntraQP );
 #if U0132_TARGET_BITS_SATURATION
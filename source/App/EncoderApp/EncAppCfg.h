@@ -95,6 +95,8 @@ protected:
   Int       m_confWinTop;
   Int       m_confWinBottom;
   Int       m_framesToBeEncoded;                              ///< number of encoded frames
+  Int       m_segmentLength;                                  ///< number of frames per concurrently encoded segment (0: disabled)
+  Int       m_segmentJobs;                                    ///< number of segments encoded at the same time (0: number of cores)
   Int       m_aiPad[2];                                       ///< number of padded pixels for width and height
   Bool      m_AccessUnitDelimiter;                            ///< add Access Unit Delimiter NAL units
   InputColourSpaceConversion m_inputColourSpaceConvert;       ///< colour space conversion to apply to input video
@@ -450,6 +452,7 @@ protected:
   Int       m_RCKeepHierarchicalBit;              ///< 0: equal bit allocation; 1: fixed ratio bit allocation; 2: adaptive ratio bit allocation
   Bool      m_RCLCULevelRC;                       ///< true: LCU level rate control; false: picture level rate control NOTE: code-tidy - rename to m_RCCtuLevelRC
   Bool      m_RCUseLCUSeparateModel;              ///< use separate R-lambda model at LCU level                        NOTE: code-tidy - rename to m_RCUseCtuSeparateModel
+  Bool      m_RCLCULookahead;                     ///< allocate the LCU target bits ahead from a pre-analysis of the picture and update the LCU models once per picture
   Int       m_RCInitialQP;                        ///< inital QP for rate control
   Bool      m_RCForceIntraQP;                     ///< force all intra picture to use initial QP or not
 #if U0132_TARGET_BITS_SATURATION
@@ -46,6 +46,8 @@ const int BilateralFilter::spatialSigmaBlockLengthOffsets[] = {20, 10, -10, 0, -
 
 const unsigned short maxPosList[34] = {6, 12, 18, 23, 29, 35, 41, 46, 52, 58, 64, 69, 75, 81, 87, 92, 98, 104, 110, 115, 121, 127, 133, 138, 144, 150, 156, 161, 167, 173, 179, 184, 190, 196};
 
+static void smoothBlockBilateralFilterCore( short block[], int width, int height, int centerWeight, const unsigned short* lookupTablePtr, int theMaxPos, const unsigned* divToMulOneOverN, const int* divToMulShift );
+
 BilateralFilter::BilateralFilter()
 {
   int numQP = MAX_QP-18+1;
@@ -53,17 +55,24 @@ BilateralFilter::BilateralFilter()
   m_bilateralFilterTable = new UShort*[numQP];
   for(int i = 0; i < numQP; i++)
   {
-    m_bilateralFilterTable[i] = new UShort[maxPosList[i]+1];
+    // one spare entry, so 32 bit wide (gather) loads of the last entry stay inside the table
+    m_bilateralFilterTable[i] = new UShort[maxPosList[i]+2];
   }
 
   // initialization
   for(int i = 0; i < numQP; i++)
   {
-    for(int k = 0; k < (maxPosList[i]+1); k++)
+    for(int k = 0; k < (maxPosList[i]+2); k++)
     {
       m_bilateralFilterTable[i][k] = 0;
     }
   }
+
+  m_smoothBlock = smoothBlockBilateralFilterCore;
+
+#if ENABLE_SIMD_OPT_BIF && defined( TARGET_SIMD_X86 )
+  initBilateralFilterX86();
+#endif
 }
 
 BilateralFilter::~BilateralFilter()
@@ -160,14 +169,8 @@ void BilateralFilter::createBilateralFilterTable(int qp)
 void BilateralFilter::smoothBlockBilateralFilter(unsigned uiWidth, unsigned uiHeight, short block[], int isInterBlock, int qp)
 {
   Int length = (Int)std::min(uiWidth, uiHeight);
-  Int rightPixel, centerPixel;
-  Int rightWeight, bottomWeight, centerWeight;
-  Int sumWeights[MAX_CU_SIZE];
-  Int sumDelta[MAX_CU_SIZE];
   Int blockLengthIndex;
 
-  Int dIB, dIR;
-
   if( length >= 16 )
   {
     blockLengthIndex = 2;
@@ -181,13 +184,22 @@ void BilateralFilter::smoothBlockBilateralFilter(unsigned uiWidth, unsigned uiHe
     blockLengthIndex = 0;
   }
 
+  const Int centerWeight = m_bilateralCenterWeightTable[blockLengthIndex + 3 * isInterBlock];
 
-  UShort *lookupTablePtr;
+  m_smoothBlock( block, uiWidth, uiHeight, centerWeight, m_bilateralFilterTable[qp-18], maxPosList[qp-18], divToMulOneOverN, divToMulShift );
+}
 
-  centerWeight = m_bilateralCenterWeightTable[blockLengthIndex + 3 * isInterBlock];
+// If you change the functionality here, consider to switch off the SIMD implementation of this function.
+static void smoothBlockBilateralFilterCore( short block[], int width, int height, int centerWeight, const unsigned short* lookupTablePtr, int theMaxPos, const unsigned* divToMulOneOverN, const int* divToMulShift )
+{
+  const unsigned uiWidth  = width;
+  const unsigned uiHeight = height;
+  Int rightPixel, centerPixel;
+  Int rightWeight, bottomWeight;
+  Int sumWeights[MAX_CU_SIZE];
+  Int sumDelta[MAX_CU_SIZE];
 
-  Int theMaxPos = maxPosList[qp-18];
-  lookupTablePtr = m_bilateralFilterTable[qp-18];
+  Int dIB, dIR;
 
   // for each pixel in block
 
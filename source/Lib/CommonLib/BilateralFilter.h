@@ -53,7 +53,7 @@ private:
   int m_bilateralCenterWeightTable[5];
   short tempblock[ MAX_CU_SIZE*MAX_CU_SIZE ];
   unsigned divToMulOneOverN[BILATERAL_FILTER_MAX_DENOMINATOR_PLUS_ONE];
-  uint8_t divToMulShift[BILATERAL_FILTER_MAX_DENOMINATOR_PLUS_ONE];
+  int divToMulShift[BILATERAL_FILTER_MAX_DENOMINATOR_PLUS_ONE];               // 32 bit entries, so both division LUTs can be gathered directly
 
   void smoothBlockBilateralFilter( unsigned uiWidth, unsigned uiHeight, short block[], int isInterBlock, int qp);
 
@@ -61,6 +61,14 @@ public:
   BilateralFilter();
   ~BilateralFilter();
 
+  void( *m_smoothBlock ) ( short block[], int width, int height, int centerWeight, const unsigned short* lookupTable, int theMaxPos, const unsigned* divToMulOneOverN, const int* divToMulShift );
+
+#if ENABLE_SIMD_OPT_BIF && defined( TARGET_SIMD_X86 )
+  void initBilateralFilterX86();
+  template <X86_VEXT vext>
+  void _initBilateralFilterX86();
+#endif
+
   void create();
   void destroy();
 
@@ -47,6 +47,10 @@
 
 #include "CommonDefX86.h"
 
+#endif
+#endif
+
+// core implementations of the buffer operations, the SIMD versions replace them in initPelBufOpsX86()
 template< typename T >
 void addAvgCore( const T* src1, int src1Stride, const T* src2, int src2Stride, T* dest, int dstStride, int width, int height, int rshift, int offset, const ClpRng& clpRng )
 {
@@ -93,6 +97,134 @@ void linTfCore( const T* src, int srcStride, Pel *dst, int dstStride, int width,
 #undef LINTF_CORE_INC
 }
 
+#if JEM_TOOLS
+template<typename T>
+void obmcBlendHorCore( T* dst, int dstStride, const T* src, int srcStride, int width, int numLines, bool subtract )
+{
+  for( int line = 0; line < numLines; line++ )
+  {
+    const int shift  = line + 2;
+    const int offset = 1 << ( line + 1 );
+
+    for( int x = 0; x < width; x++ )
+    {
+      dst[x] += subtract ? ( dst[x] - src[x] + offset ) >> shift : ( src[x] - dst[x] + offset ) >> shift;
+    }
+
+    dst += dstStride;
+    src += srcStride;
+  }
+}
+
+template<typename T>
+void obmcBlendVerCore( T* dst, int dstStride, const T* src, int srcStride, int height, int numLines, int lineStep, bool subtract )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int line = 0; line < numLines; line++ )
+    {
+      const int shift  = line + 2;
+      const int offset = 1 << ( line + 1 );
+      const int pos    = line * lineStep;
+
+      dst[pos] += subtract ? ( dst[pos] - src[pos] + offset ) >> shift : ( src[pos] - dst[pos] + offset ) >> shift;
+    }
+
+    dst += dstStride;
+    src += srcStride;
+  }
+}
+
+void licSumsCore( const Pel* ref, const Pel* rec, int num, int* sums )
+{
+  int x = 0, y = 0, xx = 0, xy = 0;
+
+  for( int k = 0; k < num; k++ )
+  {
+    x  += ref[k];
+    y  += rec[k];
+    xx += ref[k] * ref[k];
+    xy += ref[k] * rec[k];
+  }
+
+  sums[0] = x;
+  sums[1] = y;
+  sums[2] = xx;
+  sums[3] = xy;
+}
+
+template<typename T>
+void licApplyCore( T* dst, int dstStride, int width, int height, int scale, int shift, int offset, bool biPred, const ClpRng& clpRng )
+{
+  const int biShift  = biPred ? IF_INTERNAL_PREC - clpRng.bd : 0;
+  const int biOffset = biPred ? -IF_INTERNAL_OFFS : 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dst[x] = ( T ) ( rightShift( ClipPel( rightShift( scale * dst[x], shift ) + offset, clpRng ), -biShift ) + biOffset );
+    }
+
+    dst += dstStride;
+  }
+}
+
+
+void alfAccStatsCore( const int* e, int len, int stride, int yLocal, Int64* E, Int64* y )
+{
+  for( int k = 0; k < len; k++ )
+  {
+    const int ek = e[k];
+
+    for( int l = k; l < len; l++ )
+    {
+      E[l] += ek * e[l];
+    }
+
+    y[k] += ek * yLocal;
+    E    += stride;
+  }
+}
+#endif
+void saoEdgeStatsCore( const Pel* src, int srcStride, const Pel* org, int orgStride, int width, int height, int offA, int offB, Int64* diff, Int64* count )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int diffA    = src[x] - src[x + offA];
+      const int diffB    = src[x] - src[x + offB];
+      const int edgeType = ( diffA > 0 ) - ( diffA < 0 ) + ( diffB > 0 ) - ( diffB < 0 );
+
+      diff [edgeType] += org[x] - src[x];
+      count[edgeType] ++;
+    }
+
+    src += srcStride;
+    org += orgStride;
+  }
+}
+
+UInt64 calcSSECore( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height )
+{
+  UInt64 sum = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const Intermediate_Int diff = src0[x] - src1[x];
+      sum += UInt64( diff * diff );
+    }
+
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+  return sum;
+}
+
 PelBufferOps::PelBufferOps()
 {
   addAvg4 = addAvgCore<Pel>;
@@ -103,12 +235,21 @@ PelBufferOps::PelBufferOps()
 
   linTf4 = linTfCore<Pel>;
   linTf8 = linTfCore<Pel>;
-}
 
-PelBufferOps g_pelBufOP = PelBufferOps();
+  saoEdgeStats = saoEdgeStatsCore;
+  calcSSE      = calcSSECore;
+#if JEM_TOOLS
 
+  obmcBlendHor = obmcBlendHorCore<Pel>;
+  obmcBlendVer = obmcBlendVerCore<Pel>;
+
+  licSums      = licSumsCore;
+  licApply     = licApplyCore<Pel>;
+  alfAccStats  = alfAccStatsCore;
 #endif
-#endif
+}
+
+PelBufferOps g_pelBufOP = PelBufferOps();
 
 
 template<>
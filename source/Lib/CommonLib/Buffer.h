@@ -51,16 +51,15 @@
 // AreaBuf struct
 // ---------------------------------------------------------------------------
 
-#if ENABLE_SIMD_OPT_BUFFER
-#ifdef TARGET_SIMD_X86
-
 struct PelBufferOps
 {
   PelBufferOps();
 
+#if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
   void initPelBufOpsX86();
   template<X86_VEXT vext>
   void _initPelBufOpsX86();
+#endif
 
   void ( *addAvg4 )       ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height,            int shift, int offset, const ClpRng& clpRng );
   void ( *addAvg8 )       ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height,            int shift, int offset, const ClpRng& clpRng );
@@ -68,13 +67,28 @@ struct PelBufferOps
   void ( *reco8 )         ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height,                                   const ClpRng& clpRng );
   void ( *linTf4 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
   void ( *linTf8 )        ( const Pel* src0, int src0Stride,                                  Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, const ClpRng& clpRng, bool bClip );
+  // SAO: edge offset statistics, the class of a sample is sgn( s - s[offA] ) + sgn( s - s[offB] ) and diff and count point at class 0
+  void ( *saoEdgeStats )  ( const Pel* src, int srcStride, const Pel* org, int orgStride, int width, int height, int offA, int offB, Int64* diff, Int64* count );
+  // sum of squared differences, accumulated in 64 bits
+  UInt64 ( *calcSSE )     ( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height );
+#if JEM_TOOLS
+  // OBMC blending of numLines lines along a block edge, line i being weighted with 1/2^(i+2)
+  // horizontal edge: lines are rows, a negative stride walks upwards from the bottom row
+  // vertical edge:   lines are columns, lineStep = -1 walks leftwards from the right column
+  void ( *obmcBlendHor )  ( Pel *dst, int dstStride, const Pel* src, int srcStride, int width,  int numLines,               bool subtract );
+  void ( *obmcBlendVer )  ( Pel *dst, int dstStride, const Pel* src, int srcStride, int height, int numLines, int lineStep, bool subtract );
+  // LIC: sums[0..3] = sum( ref ), sum( rec ), sum( ref * ref ), sum( ref * rec ) of the template samples
+  void ( *licSums )       ( const Pel* ref, const Pel* rec, int num, int* sums );
+  // LIC: clipped linear model, followed by the conversion to the intermediate bi-prediction format if biPred is set
+  void ( *licApply )      ( Pel *dst, int dstStride, int width, int height, int scale, int shift, int offset, bool biPred, const ClpRng& clpRng );
+  // ALF encoder: E[k][l] += e[k] * e[l] for k <= l < len and y[k] += e[k] * yLocal, with the rows of E being stride apart
+  // e has to be zero padded up to stride, which is a multiple of 8, and the entries of E below the diagonal are undefined
+  void ( *alfAccStats )   ( const int* e, int len, int stride, int yLocal, Int64* E, Int64* y );
+#endif
 };
 
 extern PelBufferOps g_pelBufOP;
 
-#endif
-#endif
-
 template<typename T>
 struct AreaBuf : public Size
 {
@@ -118,19 +118,65 @@ void CodingStructure::destroy()
     m_tuIdx[ i ] = nullptr;
   }
 
-  delete[] m_motionBuf;
-  m_motionBuf = nullptr;
-
-#if JEM_TOOLS
-  delete[] m_motionBufFRUC;
-  m_motionBufFRUC = nullptr;
-#endif
+  destroyMotionBufs();
 
   m_tuCache.cache( tus );
   m_puCache.cache( pus );
   m_cuCache.cache( cus );
 }
 
+// ---------------------------------------------------------------------------
+// collocated motion field
+// ---------------------------------------------------------------------------
+
+void ColMotionField::create( const Size& lumaSize, const bool compress )
+{
+  // the same decimation as applied by the readers before the motion field was stored separately
+  const unsigned scale = compress ? 4 * std::max<Int>( 1, 4 * AMVP_DECIMATION_FACTOR / 4 ) : ( 1 << MIN_CU_LOG2 );
+
+  log2Unit = g_aucLog2[scale];
+  stride   = ( lumaSize.width  + scale - 1 ) / scale;
+  height   = ( lumaSize.height + scale - 1 ) / scale;
+
+  const unsigned num = stride * height;
+
+  info    .resize( num );
+  sliceIdx.resize( num );
+
+  for( UInt i = 0; i < NUM_REF_PIC_LIST_01; i++ )
+  {
+    mv    [i].resize( num );
+    refIdx[i].resize( num );
+  }
+}
+
+void ColMotionField::fill( const CMotionBuf& mb )
+{
+  const unsigned step = 1 << ( log2Unit - MIN_CU_LOG2 );
+
+  CHECK( stride != ( mb.width + step - 1 ) / step || height != ( mb.height + step - 1 ) / step, "Collocated motion field does not match the motion buffer" );
+
+  for( unsigned y = 0, i = 0; y < height; y++ )
+  {
+    for( unsigned x = 0; x < stride; x++, i++ )
+    {
+      const MotionInfo &mi = mb.at( x * step, y * step );
+
+      info[i] = ( mi.interDir & INFO_INTER_DIR ) | ( mi.isInter ? INFO_IS_INTER : 0 );
+#if JEM_TOOLS
+      info[i] |= mi.usesLIC ? INFO_USES_LIC : 0;
+#endif
+      sliceIdx[i] = mi.sliceIdx;
+
+      for( UInt l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+      {
+        mv    [l][i] = mi.mv    [l];
+        refIdx[l][i] = mi.refIdx[l];
+      }
+    }
+  }
+}
+
 void CodingStructure::releaseIntermediateData()
 {
   clearTUs();
@@ -617,6 +663,27 @@ void CodingStructure::create(const UnitArea& _unit, const bool isTopLayer)
   m_orgr.create( area );
 }
 
+size_t CodingStructure::getMemorySize( const UnitArea& _unit )
+{
+  size_t size = 0;
+
+  for( unsigned i = 0; i < ::getNumberValidChannels( _unit.chromaFormat ); i++ )
+  {
+    // cu, pu and tu index maps and the decomposition flags
+    size += UnitScaleArray[_unit.chromaFormat][i].scale( _unit.blocks[i].size() ).area() * ( 3 * sizeof( unsigned ) + sizeof( bool ) );
+  }
+
+  for( unsigned i = 0; i < getNumberValidComponents( _unit.chromaFormat ); i++ )
+  {
+    // coefficients and PCM samples, plus the prediction, residual, reconstruction and original residual storages
+    size += _unit.blocks[i].area() * ( sizeof( TCoeff ) + 5 * sizeof( Pel ) );
+  }
+
+  size += g_miScaling.scale( _unit.lumaSize() ).area() * sizeof( MotionInfo );
+
+  return size;
+}
+
 void CodingStructure::createInternals( const UnitArea& _unit, const bool isTopLayer )
 {
   area = _unit;
@@ -647,14 +714,9 @@ void CodingStructure::createInternals( const UnitArea& _unit, const bool isTopLa
 
   if( !isTopLayer ) createCoeffs();
 
-  unsigned _lumaAreaScaled = g_miScaling.scale( area.lumaSize() ).area();
-  m_motionBuf       = new MotionInfo[_lumaAreaScaled];
-#if JEM_TOOLS
-  if( isTopLayer )
-  {
-    m_motionBufFRUC = new MotionInfo[_lumaAreaScaled];
-  }
-#endif
+  // the motion buffers of the top layer only exist while the picture is coded, see createMotionBufs()
+  if( !isTopLayer ) m_motionBuf = new MotionInfo[g_miScaling.scale( area.lumaSize() ).area()];
+
   initStructData();
 }
 
@@ -697,6 +759,34 @@ void CodingStructure::destroyCoeffs()
   }
 }
 
+void CodingStructure::createMotionBufs()
+{
+  CHECK( parent, "createMotionBufs can only be used for the top level CodingStructure" );
+
+  const unsigned _lumaAreaScaled = g_miScaling.scale( area.lumaSize() ).area();
+
+  if( !m_motionBuf     ) m_motionBuf     = new MotionInfo[_lumaAreaScaled];
+#if JEM_TOOLS
+  if( !m_motionBufFRUC ) m_motionBufFRUC = new MotionInfo[_lumaAreaScaled];
+#endif
+
+  getMotionBuf()    .memset( 0 );
+#if JEM_TOOLS
+  getMotionBufFRUC().memset( 0 );
+#endif
+}
+
+void CodingStructure::destroyMotionBufs()
+{
+  delete[] m_motionBuf;
+  m_motionBuf = nullptr;
+
+#if JEM_TOOLS
+  delete[] m_motionBufFRUC;
+  m_motionBufFRUC = nullptr;
+#endif
+}
+
 void CodingStructure::initSubStructure( CodingStructure& subStruct, const ChannelType _chType, const UnitArea &subArea, const bool &isTuEnc )
 {
   CHECK( this == &subStruct, "Trying to init self as sub-structure" );
@@ -758,7 +848,7 @@ void CodingStructure::initSubStructure( CodingStructure& subStruct, const Channe
   }
 }
 
-void CodingStructure::useSubStructure( const CodingStructure& subStruct, const ChannelType chType, const UnitArea &subArea, const bool cpyPred /*= true*/, const bool cpyReco /*= true*/, const bool cpyOrgResi /*= true*/, const bool cpyResi /*= true*/ )
+void CodingStructure::useSubStructure( const CodingStructure& subStruct, const ChannelType chType, const UnitArea &subArea, const bool cpyPred /*= true*/, const bool cpyReco /*= true*/, const bool cpyOrgResi /*= true*/, const bool cpyResi /*= true*/, const bool cpyRecoToPic /*= true*/ )
 {
   UnitArea clippedArea = clipArea( subArea, *picture );
 
@@ -779,7 +869,7 @@ void CodingStructure::useSubStructure( const CodingStructure& subStruct, const C
 
   if( cpyPred ) picture->getPredBuf( clippedArea ).copyFrom( subPredBuf );
   if( cpyResi ) picture->getResiBuf( clippedArea ).copyFrom( subResiBuf );
-  if( cpyReco ) picture->getRecoBuf( clippedArea ).copyFrom( subRecoBuf );
+  if( cpyReco && cpyRecoToPic ) picture->getRecoBuf( clippedArea ).copyFrom( subRecoBuf );
 
   if( !subStruct.m_isTuEnc && !slice->isIntra() )
   {
@@ -1016,7 +1106,7 @@ void CodingStructure::initStructData( const int &QP, const bool &_isLosses, cons
     isLossless            = _isLosses;
   }
 
-  if( !skipMotBuf && ( !parent || ( ( slice->getSliceType() != I_SLICE ) && !m_isTuEnc ) ) )
+  if( !skipMotBuf && m_motionBuf && ( !parent || ( ( slice->getSliceType() != I_SLICE ) && !m_isTuEnc ) ) )
   {
     getMotionBuf()      .memset( 0 );
 #if JEM_TOOLS
@@ -1113,6 +1203,14 @@ const CMotionBuf CodingStructure::getMotionBuf( const Area& _area ) const
   return MotionBuf( m_motionBuf + rsAddr( miArea.pos(), selfArea.pos(), selfArea.width ), selfArea.width, miArea.size() );
 }
 
+void CodingStructure::storeColMotion()
+{
+  CHECK( parent, "The collocated motion field can only be stored for the top level CodingStructure" );
+
+  m_colMotion.create( area.lumaSize(), !pcv->noMotComp );
+  m_colMotion.fill  ( getMotionBuf() );
+}
+
 MotionInfo& CodingStructure::getMotionInfo( const Position& pos )
 {
   CHECKD( !area.Y().contains( pos ), "Trying to access motion information outside of this coding structure" );
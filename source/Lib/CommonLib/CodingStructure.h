@@ -61,6 +61,44 @@ enum PictureType
 
 extern XUCache g_globalUnitCache;
 
+// ---------------------------------------------------------------------------
+// collocated motion field
+// ---------------------------------------------------------------------------
+
+// compact copy of the motion of a coded picture as it is accessed when the picture serves as collocated picture
+// (TMVP, ATMVP and FRUC), stored in a structure-of-arrays layout at the motion compression granularity
+struct ColMotionField
+{
+  enum InfoFlags
+  {
+    INFO_INTER_DIR = 0x3,
+    INFO_IS_INTER  = 0x4,
+    INFO_USES_LIC  = 0x8,
+  };
+
+  unsigned              log2Unit;
+  unsigned              stride;
+  unsigned              height;
+
+  std::vector<UChar>    info;
+  std::vector<UShort>   sliceIdx;
+  std::vector<Mv>       mv    [NUM_REF_PIC_LIST_01];
+  std::vector<int8_t>   refIdx[NUM_REF_PIC_LIST_01];
+
+  ColMotionField() : log2Unit( MIN_CU_LOG2 ), stride( 0 ), height( 0 ) { }
+
+  void     create  ( const Size& lumaSize, const bool compress );
+  void     fill    ( const CMotionBuf& mb );
+
+  unsigned idx     ( const Position& pos ) const { return ( pos.y >> log2Unit ) * stride + ( pos.x >> log2Unit ); }
+
+  bool     isInter ( const unsigned i )    const { return ( info[i] & INFO_IS_INTER ) != 0; }
+  int      interDir( const unsigned i )    const { return   info[i] & INFO_INTER_DIR; }
+#if JEM_TOOLS
+  bool     usesLIC ( const unsigned i )    const { return ( info[i] & INFO_USES_LIC ) != 0; }
+#endif
+};
+
 // ---------------------------------------------------------------------------
 // coding structure
 // ---------------------------------------------------------------------------
@@ -94,12 +132,20 @@ public:
   void create( const UnitArea &_unit, const bool isTopLayer );
   void create( const ChromaFormat &_chromaFormat, const Area& _area, const bool isTopLayer );
   void destroy();
+
+  // approximate amount of memory allocated by create() for a coding structure which is not the top layer
+  static size_t getMemorySize( const UnitArea& _unit );
+
   void releaseIntermediateData();
 
   void rebindPicBufs();
   void createCoeffs();
   void destroyCoeffs();
 
+  // the full resolution motion of the top level CS is only kept while its picture is coded
+  void createMotionBufs();
+  void destroyMotionBufs();
+
   void allocateVectorsAtPicLevel();
 
   // ---------------------------------------------------------------------------
@@ -163,7 +209,7 @@ public:
   void initSubStructure(      CodingStructure& cs, const ChannelType chType, const UnitArea &subArea, const bool &isTuEnc);
 
   void copyStructure   (const CodingStructure& cs, const ChannelType chType, const bool copyTUs = false, const bool copyRecoBuffer = false);
-  void useSubStructure (const CodingStructure& cs, const ChannelType chType, const UnitArea &subArea, const bool cpyPred, const bool cpyReco, const bool cpyOrgResi, const bool cpyResi);
+  void useSubStructure (const CodingStructure& cs, const ChannelType chType, const UnitArea &subArea, const bool cpyPred, const bool cpyReco, const bool cpyOrgResi, const bool cpyResi, const bool cpyRecoToPic = true);
   void useSubStructure (const CodingStructure& cs, const ChannelType chType,                          const bool cpyPred, const bool cpyReco, const bool cpyOrgResi, const bool cpyResi) { useSubStructure(cs, chType, cs.area, cpyPred, cpyReco, cpyOrgResi, cpyResi); }
 
   void clearTUs();
@@ -217,9 +263,14 @@ private:
 #if JEM_TOOLS
   MotionInfo *m_motionBufFRUC;
 #endif
+  ColMotionField m_colMotion;
 
 public:
 
+  // only valid for the top level CS of a coded picture, after storeColMotion() was called
+  const ColMotionField& getColMotion() const { return m_colMotion; }
+  void                  storeColMotion();
+
   MotionBuf getMotionBuf( const     Area& _area );
   MotionBuf getMotionBuf( const UnitArea& _area ) { return getMotionBuf( _area.Y() ); }
   MotionBuf getMotionBuf()                        { return getMotionBuf(  area.Y() ); }
@@ -98,6 +98,18 @@ InterPrediction::InterPrediction()
     }
     m_cYuvPredTempDMVR[ch] = nullptr;
   }
+
+  for( Int i = 0; i < FRUC_COST_CACHE_SIZE; i++ )
+  {
+    m_frucCostCache[i].generation = 0;
+  }
+  m_frucCostCacheGen = 1;
+
+  for( Int i = 0; i < LIC_PARAM_CACHE_SIZE; i++ )
+  {
+    m_LICParamCache[i].generation = 0;
+  }
+  m_LICParamCacheGen = 0;
 #endif
 }
 
@@ -769,64 +781,90 @@ Void InterPrediction::xPredAffineBlk(const ComponentID& compID, const Prediction
 
   const Int shift = iBit - 4 + VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE + 2;
 
+  const Int numBlkX = cxWidth / blockWidth;
+  Int blkMvHor[MAX_CU_SIZE / AFFINE_MIN_BLOCK_SIZE];
+  Int blkMvVer[MAX_CU_SIZE / AFFINE_MIN_BLOCK_SIZE];
+  CHECK( numBlkX > MAX_CU_SIZE / AFFINE_MIN_BLOCK_SIZE, "Too many affine sub-blocks" );
+
+  PelBuf &dstBuf = dstPic.bufs[compID];
+
   // get prediction block by block
   for ( Int h = 0; h < cxHeight; h += blockHeight )
   {
-    for ( Int w = 0; w < cxWidth; w += blockWidth )
+    // derive the clipped motion of all sub-blocks of the row first
+    for ( Int i = 0; i < numBlkX; i++ )
     {
       Int iMvScaleTmpHor = ( iMvScaleHor + iDMvHorX * iHalfBW + iDMvVerX * iHalfBH ) >> shift;
       Int iMvScaleTmpVer = ( iMvScaleVer + iDMvHorY * iHalfBW + iDMvVerY * iHalfBH ) >> shift;
 
       // clip and scale
-      iMvScaleTmpHor = std::min<int>( iHorMax, std::max<int>( iHorMin, iMvScaleTmpHor ) );
-      iMvScaleTmpVer = std::min<int>( iVerMax, std::max<int>( iVerMin, iMvScaleTmpVer ) );
+      blkMvHor[i] = std::min<int>( iHorMax, std::max<int>( iHorMin, iMvScaleTmpHor ) );
+      blkMvVer[i] = std::min<int>( iVerMax, std::max<int>( iVerMin, iMvScaleTmpVer ) );
+
+      // switch from x to x+AffineBlockSize, add deltaMvHor
+      iMvScaleHor += (iDMvHorX*blockWidth);
+      iMvScaleVer += (iDMvHorY*blockWidth);
+    }
+
+    for ( Int i = 0; i < numBlkX; )
+    {
+      // neighbouring sub-blocks with the same motion read adjacent reference samples, predict them at once
+      Int numBlk = 1;
+      while( i + numBlk < numBlkX && blkMvHor[i + numBlk] == blkMvHor[i] && blkMvVer[i + numBlk] == blkMvVer[i] )
+      {
+        numBlk++;
+      }
+
+      const Int w        = i * blockWidth;
+      const Int runWidth = numBlk * blockWidth;
 
       // get the MV in high precision
       Int xFrac, yFrac, xInt, yInt;
 
       if (!iScaleX)
       {
-        xInt  = iMvScaleTmpHor >> 4;
-        xFrac = iMvScaleTmpHor & 15;
+        xInt  = blkMvHor[i] >> 4;
+        xFrac = blkMvHor[i] & 15;
       }
       else
       {
-        xInt  = iMvScaleTmpHor >> 5;
-        xFrac = iMvScaleTmpHor & 31;
+        xInt  = blkMvHor[i] >> 5;
+        xFrac = blkMvHor[i] & 31;
       }
       if (!iScaleY)
       {
-        yInt  = iMvScaleTmpVer >> 4;
-        yFrac = iMvScaleTmpVer & 15;
+        yInt  = blkMvVer[i] >> 4;
+        yFrac = blkMvVer[i] & 15;
       }
       else
       {
-        yInt  = iMvScaleTmpVer >> 5;
-        yFrac = iMvScaleTmpVer & 31;
+        yInt  = blkMvVer[i] >> 5;
+        yFrac = blkMvVer[i] & 31;
       }
 
       const CPelBuf refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, pu.blocks[compID].offset(xInt + w, yInt + h), pu.blocks[compID] ) );
-      PelBuf &dstBuf = dstPic.bufs[compID];
 
       if ( yFrac == 0 )
       {
-        m_if.filterHor( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, xFrac, !bi, chFmt, clpRng );
+        m_if.filterHor( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, runWidth, blockHeight, xFrac, !bi, chFmt, clpRng );
       }
       else if ( xFrac == 0 )
       {
-        m_if.filterVer( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, yFrac, true, !bi, chFmt, clpRng );
+        m_if.filterVer( compID, (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, runWidth, blockHeight, yFrac, true, !bi, chFmt, clpRng );
+      }
+      else if ( isLuma( compID ) && runWidth == 4 && blockHeight == 4 )
+      {
+        m_if.filterLuma4x4( (Pel*) refBuf.buf, refBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, xFrac, yFrac, !bi, clpRng );
       }
       else
       {
-        m_if.filterHor( compID, (Pel*) refBuf.buf - ((vFilterSize>>1) -1)*refBuf.stride, refBuf.stride, tmpBuf.buf, tmpBuf.stride, blockWidth, blockHeight+vFilterSize-1, xFrac, false,      chFmt, clpRng);
+        m_if.filterHor( compID, (Pel*) refBuf.buf - ((vFilterSize>>1) -1)*refBuf.stride, refBuf.stride, tmpBuf.buf, tmpBuf.stride, runWidth, blockHeight+vFilterSize-1, xFrac, false,      chFmt, clpRng);
         JVET_J0090_SET_CACHE_ENABLE( false );
-        m_if.filterVer( compID, tmpBuf.buf + ((vFilterSize>>1) -1)*tmpBuf.stride, tmpBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, blockWidth, blockHeight, yFrac, false, !bi, chFmt, clpRng);
+        m_if.filterVer( compID, tmpBuf.buf + ((vFilterSize>>1) -1)*tmpBuf.stride, tmpBuf.stride, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, runWidth, blockHeight, yFrac, false, !bi, chFmt, clpRng);
         JVET_J0090_SET_CACHE_ENABLE( true );
       }
 
-      // switch from x to x+AffineBlockSize, add deltaMvHor
-      iMvScaleHor += (iDMvHorX*blockWidth);
-      iMvScaleVer += (iDMvHorY*blockWidth);
+      i += numBlk;
     }
 
     // switch from y to y+AffineBlockSize add deltaMvVer
@@ -857,6 +895,18 @@ int getMSB( unsigned x )
 }
 
 #if JEM_TOOLS
+Void InterPrediction::resetLICParamCache()
+{
+  if( ++m_LICParamCacheGen == 0 )
+  {
+    for( Int i = 0; i < LIC_PARAM_CACHE_SIZE; i++ )
+    {
+      m_LICParamCache[i].generation = 0;
+    }
+    m_LICParamCacheGen = 1;
+  }
+}
+
 void InterPrediction::xGetLICParams( const CodingUnit& cu,
                                      const ComponentID compID,
                                      const Picture&    refPic,
@@ -883,10 +933,32 @@ void InterPrediction::xGetLICParams( const CodingUnit& cu,
   const Picture&  currPic       = *cu.cs->picture;
   const int       dimShift      = minDimBit - minStepBit;
 
-  //----- get correlation data -----
-  int x = 0, y = 0, xx = 0, xy = 0, cntShift = 0;
   const CodingUnit* const cuAbove = cu.cs->getCU( cu.blocks[compID].pos().offset(  0, -1 ), toChannelType( compID ) );
   const CodingUnit* const cuLeft  = cu.cs->getCU( cu.blocks[compID].pos().offset( -1,  0 ), toChannelType( compID ) );
+
+  //----- look up the model of an earlier call with the same template -----
+  LICParamCache* cache = nullptr;
+  if( m_LICParamCacheGen )
+  {
+    const CompArea& area = cu.blocks[compID];
+    const UInt      hash = ( UInt( area.x ) * 0x9E3779B1u ) ^ ( UInt( area.y ) * 0x85EBCA77u ) ^ ( UInt( horIntMv ) * 0xC2B2AE3Du ) ^ ( UInt( verIntMv ) * 0x27D4EB2Fu ) ^ ( UInt( refPic.getPOC() * MAX_NUM_COMPONENT + compID ) * 0x165667B1u );
+
+    cache = &m_LICParamCache[hash >> ( 32 - LIC_PARAM_CACHE_LOG2 )];
+
+    if( cache->generation == m_LICParamCacheGen && cache->area == area && cache->refPic == &refPic
+      && cache->horIntMv == horIntMv && cache->verIntMv == verIntMv && cache->above == ( cuAbove != nullptr ) && cache->left == ( cuLeft != nullptr ) )
+    {
+      shift  = cache->shift;
+      scale  = cache->scale;
+      offset = cache->offset;
+      return;
+    }
+  }
+
+  //----- get correlation data -----
+  Pel refVals[2 * MAX_CU_SIZE];
+  Pel recVals[2 * MAX_CU_SIZE];
+  int num = 0, cntShift = 0;
   const CPelBuf recBuf            = cuAbove || cuLeft ? currPic.getRecoBuf( cu.cs->picture->blocks[compID] ) : CPelBuf();
   const CPelBuf refBuf            = cuAbove || cuLeft ? refPic .getRecoBuf( refPic.blocks[compID]          ) : CPelBuf();
 
@@ -900,16 +972,12 @@ void InterPrediction::xGetLICParams( const CodingUnit& cu,
     const Pel*    ref     = refBuf.bufAt( cu.blocks[compID].pos().offset( hOff, vOff ) );
     const Pel*    rec     = recBuf.bufAt( cu.blocks[compID].pos().offset(    0,   -1 ) );
 
-    for( int k = 0; k < numSteps; k++ )
+    for( int k = 0; k < numSteps; k++, num++ )
     {
-      int refVal  = ref[( ( k * cuWidth ) >> dimShift )] >> precShift;
-      int recVal  = rec[( ( k * cuWidth ) >> dimShift )] >> precShift;
+      refVals[num] = ref[( ( k * cuWidth ) >> dimShift )] >> precShift;
+      recVals[num] = rec[( ( k * cuWidth ) >> dimShift )] >> precShift;
 
       JVET_J0090_CACHE_ACCESS( &ref[( ( k * cuWidth ) >> dimShift )], __FILE__, __LINE__ );
-      x          += refVal;
-      y          += recVal;
-      xx         += refVal * refVal;
-      xy         += refVal * recVal;
     }
 
     cntShift = dimShift;
@@ -924,19 +992,19 @@ void InterPrediction::xGetLICParams( const CodingUnit& cu,
     const Pel*    ref     = refBuf.bufAt( cu.blocks[compID].pos().offset( hOff, vOff ) );
     const Pel*    rec     = recBuf.bufAt( cu.blocks[compID].pos().offset(   -1,    0 ) );
 
-    for( int k = 0; k < numSteps; k++ )
+    for( int k = 0; k < numSteps; k++, num++ )
     {
-      int refVal     = ref[refBuf.stride * ( ( k * cuHeight ) >> dimShift )] >> precShift;
-      int recVal     = rec[recBuf.stride * ( ( k * cuHeight ) >> dimShift )] >> precShift;
-      x             += refVal;
-      y             += recVal;
-      xx            += refVal * refVal;
-      xy            += refVal * recVal;
+      refVals[num]   = ref[refBuf.stride * ( ( k * cuHeight ) >> dimShift )] >> precShift;
+      recVals[num]   = rec[recBuf.stride * ( ( k * cuHeight ) >> dimShift )] >> precShift;
     }
 
     cntShift += ( cntShift ? 1 : dimShift );
   }
 
+  int sums[4] = { 0, 0, 0, 0 };
+  g_pelBufOP.licSums( refVals, recVals, num, sums );
+  const int x = sums[0], y = sums[1], xx = sums[2], xy = sums[3];
+
   //----- determine scale and offset -----
   shift = m_LICShift;
   if( cntShift == 0 )
@@ -969,6 +1037,20 @@ void InterPrediction::xGetLICParams( const CodingUnit& cu,
   const int minOffset     = -1 - maxOffset;
             offset        = ( sumY - ( ( scale * sumX ) >> shift ) + ( ( 1 << ( cntShift ) ) >> 1 ) ) >> cntShift;
             offset        = Clip3( minOffset, maxOffset, offset );
+
+  if( cache )
+  {
+    cache->generation = m_LICParamCacheGen;
+    cache->area       = cu.blocks[compID];
+    cache->refPic     = &refPic;
+    cache->horIntMv   = horIntMv;
+    cache->verIntMv   = verIntMv;
+    cache->above      = cuAbove != nullptr;
+    cache->left       = cuLeft  != nullptr;
+    cache->shift      = shift;
+    cache->scale      = scale;
+    cache->offset     = offset;
+  }
 }
 
 void InterPrediction::xLocalIlluComp( const PredictionUnit& pu,
@@ -982,18 +1064,9 @@ void InterPrediction::xLocalIlluComp( const PredictionUnit& pu,
 
   xGetLICParams( *pu.cu, compID, refPic, mv, shift, scale, offset );
 
-  const int bitDepth   = pu.cs->sps->getBitDepth( toChannelType( compID ) );
   const ClpRng& clpRng = pu.cu->cs->slice->clpRng(compID);
 
-  dstBuf.linearTransform( scale, shift, offset, true, clpRng );
-
-  if( biPred )
-  {
-    const int biShift   =  IF_INTERNAL_PREC - bitDepth;
-    const Pel biOffset  = -IF_INTERNAL_OFFS;
-    ClpRng clpRngDummy;
-    dstBuf.linearTransform( 1, -biShift, biOffset, false, clpRngDummy );
-  }
+  g_pelBufOP.licApply( dstBuf.buf, dstBuf.stride, dstBuf.width, dstBuf.height, scale, shift, offset, biPred, clpRng );
 }
 
 
@@ -1015,8 +1088,6 @@ void InterPrediction::applyBiOptFlow( const PredictionUnit &pu, const CPelUnitBu
   const int     iSrc1Stride = pcYuvSrc1.Y().stride;
   Pel*          pDstY       = pcYuvDst.Y().buf;
   const int     iDstStride  = pcYuvDst.Y().stride;
-  const Pel*    pSrcY0Temp  = pSrcY0;
-  const Pel*    pSrcY1Temp  = pSrcY1;
 
   int dT0 = pu.cs->slice->getRefPOC( REF_PIC_LIST_0 , iRefIdx0 ) - pu.cs->slice->getPOC();
   int dT1 = pu.cs->slice->getPOC() - pu.cs->slice->getRefPOC( REF_PIC_LIST_1 , iRefIdx1 );
@@ -1061,67 +1132,28 @@ void InterPrediction::applyBiOptFlow( const PredictionUnit &pu, const CPelUnitBu
   const Int64 denom_min_1     = 700 * (1<<(bitDepth-8)) * (1<<(bitDepth-8));
   const Int64 denom_min_2     = denom_min_1<<1;
 
-  Int64* m_piDotProductTemp1 = m_piDotProduct1;
-  Int64* m_piDotProductTemp2 = m_piDotProduct2;
-  Int64* m_piDotProductTemp3 = m_piDotProduct3;
-  Int64* m_piDotProductTemp5 = m_piDotProduct5;
-  Int64* m_piDotProductTemp6 = m_piDotProduct6;
-
-  Int64 temp=0, tempX=0, tempY=0;
-  for( int y = 0; y < iHeightG; y++ )
-  {
-    for( int x = 0; x < iWidthG; x++ )
-    {
-      temp  = (Int64)( pSrcY0Temp[x] - pSrcY1Temp[x] );
-      tempX = (Int64)( pGradX0   [x] + pGradX1   [x] );
-      tempY = (Int64)( pGradY0   [x] + pGradY1   [x] );
-      m_piDotProductTemp1[x] =  tempX * tempX;
-      m_piDotProductTemp2[x] =  tempX * tempY;
-      m_piDotProductTemp3[x] = -tempX * temp<<5;
-      m_piDotProductTemp5[x] =  tempY * tempY<<1;
-      m_piDotProductTemp6[x] = -tempY * temp<<6;
-    }
-    pSrcY0Temp          += iSrc0Stride;
-    pSrcY1Temp          += iSrc1Stride;
-    pGradX0             += iWidthG;
-    pGradX1             += iWidthG;
-    pGradY0             += iWidthG;
-    pGradY1             += iWidthG;
-    m_piDotProductTemp1 += iWidthG;
-    m_piDotProductTemp2 += iWidthG;
-    m_piDotProductTemp3 += iWidthG;
-    m_piDotProductTemp5 += iWidthG;
-    m_piDotProductTemp6 += iWidthG;
-  }
+  Int64* const piDotProducts[BIO_NUM_GRAD_SUMS] = { m_piDotProduct1, m_piDotProduct2, m_piDotProduct3, m_piDotProduct5, m_piDotProduct6 };
+
+  m_if.m_bioGradSums( pSrcY0, iSrc0Stride, pSrcY1, iSrc1Stride, pGradX0, pGradX1, pGradY0, pGradY1, iWidthG, iHeightG, piDotProducts, m_piBlkGradSums );
 
   Int xUnit = (iWidth >> 2);
   Int yUnit = (iHeight >> 2);
 
-  Pel *pDstY0 = pDstY;
-  pGradX0 = m_pGradX0; pGradX1 = m_pGradX1;
-  pGradY0 = m_pGradY0; pGradY1 = m_pGradY1;
+  Int blkVx[( MAX_CU_SIZE >> 2 ) * ( MAX_CU_SIZE >> 2 )];
+  Int blkVy[( MAX_CU_SIZE >> 2 ) * ( MAX_CU_SIZE >> 2 )];
 
   for (Int yu = 0; yu < yUnit; yu++)
   {
     for (Int xu = 0; xu < xUnit; xu++)
     {
-      Int64 sGxdI = 0, sGydI = 0, sGxGy = 0, sGx2 = 0, sGy2 = 0;
-      Int64 tmpx = 0, tmpy = 0;
-
-      m_piDotProductTemp1 = m_piDotProduct1 + ((yu*iWidthG + xu) << 2);
-      m_piDotProductTemp2 = m_piDotProduct2 + ((yu*iWidthG + xu) << 2);
-      m_piDotProductTemp3 = m_piDotProduct3 + ((yu*iWidthG + xu) << 2);
-      m_piDotProductTemp5 = m_piDotProduct5 + ((yu*iWidthG + xu) << 2);
-      m_piDotProductTemp6 = m_piDotProduct6 + ((yu*iWidthG + xu) << 2);
+      const Int64* blkSums = m_piBlkGradSums + ( yu * xUnit + xu ) * BIO_NUM_GRAD_SUMS;
 
-      calcBlkGradient(xu << 2, yu << 2, m_piDotProductTemp1, m_piDotProductTemp2, m_piDotProductTemp3, m_piDotProductTemp5, m_piDotProductTemp6,
-                      sGx2, sGy2, sGxGy, sGxdI, sGydI, iWidthG, iHeightG);
-
-      sGxdI >>= 4;
-      sGydI >>= 4;
-      sGxGy >>= 4;
-      sGx2 >>= 4;
-      sGy2 >>= 4;
+      Int64 sGx2  = blkSums[0] >> 4;
+      Int64 sGxGy = blkSums[1] >> 4;
+      Int64 sGxdI = blkSums[2] >> 4;
+      Int64 sGy2  = blkSums[3] >> 4;
+      Int64 sGydI = blkSums[4] >> 4;
+      Int64 tmpx = 0, tmpy = 0;
 
       sGx2 += regularizator_1;
       sGy2 += regularizator_2;
@@ -1137,31 +1169,13 @@ void InterPrediction::applyBiOptFlow( const PredictionUnit &pu, const CPelUnitBu
         tmpy = Clip3(-limit, limit, tmpy);
       }
 
-      pSrcY0Temp = pSrcY0 + ((yu*iSrc0Stride + xu) << 2);
-      pSrcY1Temp = pSrcY1 + ((yu*iSrc0Stride + xu) << 2);
-      pGradX0 = m_pGradX0 + ((yu*iWidthG + xu) << 2);
-      pGradX1 = m_pGradX1 + ((yu*iWidthG + xu) << 2);
-      pGradY0 = m_pGradY0 + ((yu*iWidthG + xu) << 2);
-      pGradY1 = m_pGradY1 + ((yu*iWidthG + xu) << 2);
-
-      pDstY0 = pDstY + ((yu*iDstStride + xu) << 2);
-
-      // apply BIO offset for the sub-block
-      for (int y = 0; y < 4; y++)
-      {
-        for (int x = 0; x < 4; x++)
-        {
-          Int b = (Int)tmpx * (pGradX0[x] - pGradX1[x]) + (Int)tmpy * (pGradY0[x] - pGradY1[x]);
-          b = (b > 0) ? ((b + 32) >> 6) : (-((-b + 32) >> 6));
-
-          pDstY0[x] = ( ClipPel( ( Short ) ( ( pSrcY0Temp[x] + pSrcY1Temp[x] + b + offset ) >> shiftNum ), clpRng ) );
-        }
-        pDstY0 += iDstStride; pSrcY0Temp += iSrc0Stride; pSrcY1Temp += iSrc1Stride;
-        pGradX0 += iWidthG; pGradX1 += iWidthG; pGradY0 += iWidthG; pGradY1 += iWidthG;
-      }
-
+      blkVx[yu * xUnit + xu] = (Int)tmpx;
+      blkVy[yu * xUnit + xu] = (Int)tmpy;
     }  // xu
   }  // yu
+
+  // apply BIO offset for all sub-blocks
+  m_if.m_bioApply( pSrcY0, iSrc0Stride, pSrcY1, iSrc1Stride, pGradX0, pGradX1, pGradY0, pGradY1, pDstY, iDstStride, iWidth, iHeight, blkVx, blkVy, shiftNum, offset, clpRng );
 }
 #endif
 
@@ -1353,24 +1367,71 @@ Void InterPrediction::subBlockOBMC( PredictionUnit  &pu, PelUnitBuf* pDst, Bool
   const Bool bSubMotion    = ePartSize == SIZE_2Nx2N && ( bATMVP || bFruc || bAffine );
 #endif
 
-  MotionInfo currMi  = pu.getMotionInfo();
   MotionInfo NeighMi = MotionInfo();
 
-  Int maxDir =  bNormal2Nx2N ? 2 : 4;
-
-  for (Int iSubX = 0; iSubX < uiWidthInBlock; iSubX += uiStep)
+  if( bNormal2Nx2N )
   {
-    for (Int iSubY = 0; iSubY < uiHeightInBlock; iSubY += uiStep)
+    // only the top row and the left column are blended, with the same weights for all sub-blocks. Sub-blocks
+    // that see the same neighboring motion are predicted in one go, unless the prediction depends on the block
+    // position (LIC template) or is refined per block (DMVR), in which case every run falls back to single blocks
+    const Bool bDMVR       = cs.sps->getSpsNext().getUseDMVR() && pu.mvRefine && pu.mergeFlag && pu.mergeType == MRG_TYPE_DEFAULT_N && !pu.frucMrgMode;
+    const Bool bMergeRuns  = !pu.cu->LICFlag;
+
+    for( Int iDir = 0; iDir < 2; iDir++ ) //iDir: 0 - above, 1 - left
     {
-      if (bNormal2Nx2N && iSubX && iSubY)
+      const Int  iNumBlocks = iDir == 0 ? uiWidthInBlock : uiHeightInBlock;
+      MotionInfo runMi;
+      Int        iRunStart  = -1;
+
+      for( Int iSub = 0; iSub <= iNumBlocks; iSub += uiStep )
       {
-        continue;
+        const Position posSubBlock = iDir == 0 ? Position( iSub * uiMinCUW, 0 ) : Position( 0, iSub * uiMinCUW );
+        const Bool     bAvailable  = iSub < iNumBlocks && PU::getNeighborMotion( pu, NeighMi, posSubBlock, iDir, false );
+
+        if( iRunStart >= 0 && ( !bAvailable || NeighMi != runMi ) )
+        {
+          Bool bSplitRun = !bMergeRuns;
+
+          if( bDMVR && !bSplitRun )
+          {
+            MotionInfo currMi = pu.getMotionInfo();
+            pu                = runMi;
+            bSplitRun         = PU::isBiPredFromDifferentDir( pu );
+            pu                = currMi;
+          }
+
+          const Int iRunLength = bSplitRun ? uiStep : iSub - iRunStart;
+
+          for( Int iBlk = iRunStart; iBlk < iSub; iBlk += iRunLength )
+          {
+            const Position posBlk = iDir == 0 ? Position( iBlk * uiMinCUW, 0 ) : Position( 0, iBlk * uiMinCUW );
+            const Size     blkSize( iDir == 0 ? iRunLength * uiMinCUW : uiOBMCBlkSize, iDir == 0 ? uiOBMCBlkSize : iRunLength * uiMinCUW );
+
+            xSubBlockOBMCArea( pu, runMi, Area( orgPuArea.lumaPos().offset( posBlk.x, posBlk.y ), blkSize ), pcYuvPred, pcYuvTmpPred1, iDir, bOBMCSimp, bOBMC4ME );
+          }
+
+          iRunStart = -1;
+        }
+
+        if( bAvailable && iRunStart < 0 )
+        {
+          runMi     = NeighMi;
+          iRunStart = iSub;
+        }
       }
+    }
+
+    return;
+  }
 
+  for (Int iSubX = 0; iSubX < uiWidthInBlock; iSubX += uiStep)
+  {
+    for (Int iSubY = 0; iSubY < uiHeightInBlock; iSubY += uiStep)
+    {
       Bool bCURBoundary = bVerticalPU   ? ( iSubX == uiWidhtInCU  - uiStep ) : b2ndPU ? iSubX + i1stPUWidth   == uiWidhtInCU  - uiStep : ( iSubX == uiWidhtInCU  - uiStep ) ;
       Bool bCUBBoundary = bHorizontalPU ? ( iSubY == uiHeightInCU - uiStep ) : b2ndPU ? iSubY + i1stPUHeight  == uiHeightInCU - uiStep : ( iSubY == uiHeightInCU - uiStep ) ;
 
-      for (Int iDir = 0; iDir < maxDir; iDir++) //iDir: 0 - above, 1 - left, 2 - below, 3 - right
+      for (Int iDir = 0; iDir < 4; iDir++) //iDir: 0 - above, 1 - left, 2 - below, 3 - right
       {
         if ((iDir == 3 && bCURBoundary) || (iDir == 2 && bCUBBoundary))
         {
@@ -1380,34 +1441,24 @@ Void InterPrediction::subBlockOBMC( PredictionUnit  &pu, PelUnitBuf* pDst, Bool
         Bool bVerPUBound = false;
         Bool bHorPUBound = false;
 
-        if( bNormal2Nx2N ) //skip unnecessary check for CU boundary
+        Bool bCheckNeig = bSubMotion || ( iSubX == 0 && iDir == 1 ) || ( iSubY == 0 && iDir == 0 ); //CU boundary or NxN or 2nx2n_ATMVP
+        if( !bCheckNeig && bTwoPUs )
         {
-          if( ( iDir == 1 && !iSubY && iSubX ) || ( iDir == 0 && !iSubX && iSubY ) )
+          bCheckNeig |= bFruc;
+          bCheckNeig |= bATMVP;
+
+          //PU boundary
+          if( !b2ndPU )
           {
-            continue;
+            bVerPUBound = bVerticalPU   && ( ( iDir == 2 && iSubY == i1stPUHeight - uiStep ) );
+            bHorPUBound = bHorizontalPU && ( ( iDir == 3 && iSubX == i1stPUWidth  - uiStep ) );
           }
+
+          bCheckNeig |= ( bVerPUBound || bHorPUBound );
         }
-        else
+        if( !bCheckNeig )
         {
-          Bool bCheckNeig = bSubMotion || ( iSubX == 0 && iDir == 1 ) || ( iSubY == 0 && iDir == 0 ); //CU boundary or NxN or 2nx2n_ATMVP
-          if( !bCheckNeig && bTwoPUs )
-          {
-            bCheckNeig |= bFruc;
-            bCheckNeig |= bATMVP;
-
-            //PU boundary
-            if( !b2ndPU )
-            {
-              bVerPUBound = bVerticalPU   && ( ( iDir == 2 && iSubY == i1stPUHeight - uiStep ) );
-              bHorPUBound = bHorizontalPU && ( ( iDir == 3 && iSubX == i1stPUWidth  - uiStep ) );
-            }
-
-            bCheckNeig |= ( bVerPUBound || bHorPUBound );
-          }
-          if( !bCheckNeig )
-          {
-            continue;
-          }
+          continue;
         }
 
         Bool bSubBlockOBMCSimp = ( bOBMCSimp || ( (pu.mergeType == MRG_TYPE_SUBPU_ATMVP || pu.mergeType == MRG_TYPE_SUBPU_ATMVP_EXT ) && ( 1 << pu.cs->sps->getSpsNext().getSubPuMvpLog2Size() ) == 4 ) );
@@ -1416,39 +1467,50 @@ Void InterPrediction::subBlockOBMC( PredictionUnit  &pu, PelUnitBuf* pDst, Bool
 
         if( PU::getNeighborMotion( pu, NeighMi, Position( iSubX * uiMinCUW, iSubY * uiMinCUW ), iDir, ( bATMVP || bFruc || bAffine ) ) )
         {
-          //store temporary motion information
-          pu              = NeighMi;
-          pu.cu->partSize = SIZE_2Nx2N;
-          pu.cu->affine   = false;
-          pu.UnitArea::operator=( UnitArea( pu.chromaFormat, Area( orgPuArea.lumaPos().offset( iSubX * uiMinCUW, iSubY * uiMinCUW ), Size{ uiOBMCBlkSize, uiOBMCBlkSize } ) ) );
+          xSubBlockOBMCArea( pu, NeighMi, Area( orgPuArea.lumaPos().offset( iSubX * uiMinCUW, iSubY * uiMinCUW ), Size{ uiOBMCBlkSize, uiOBMCBlkSize } ), pcYuvPred, pcYuvTmpPred1, iDir, bSubBlockOBMCSimp, bOBMC4ME );
+        }
+      }
+    }
+  }
+}
 
-          const UnitArea predArea = UnitAreaRelative( orgPuArea, pu );
+// Function for predicting an area of the current PU with neighboring motion and blending it into the prediction at the given edge.
+Void InterPrediction::xSubBlockOBMCArea( PredictionUnit &pu, const MotionInfo &neighMi, const Area &blkArea, PelUnitBuf &pcYuvPred, PelUnitBuf &pcYuvTmpPred, Int iDir, Bool bOBMCSimp, Bool bOBMC4ME )
+{
+  const PartSize   ePartSize = pu.cu->partSize;
+  const Bool       bAffine   = pu.cu->affine;
+  const UnitArea   orgPuArea = pu;
+  const MotionInfo currMi    = pu.getMotionInfo();
 
-          PelUnitBuf cPred = pcYuvPred    .subBuf( predArea );
-          PelUnitBuf cTmp1 = pcYuvTmpPred1.subBuf( predArea );
+  //store temporary motion information
+  pu              = neighMi;
+  pu.cu->partSize = SIZE_2Nx2N;
+  pu.cu->affine   = false;
+  pu.UnitArea::operator=( UnitArea( pu.chromaFormat, blkArea ) );
 
-          xSubBlockMotionCompensation( pu, cTmp1 );
+  const UnitArea predArea = UnitAreaRelative( orgPuArea, pu );
 
-          if( bOBMC4ME )
-          {
-            xSubtractOBMC( pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
-          }
-          else
-          {
-            xSubblockOBMC( COMPONENT_Y,  pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
-            xSubblockOBMC( COMPONENT_Cb, pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
-            xSubblockOBMC( COMPONENT_Cr, pu, cPred, cTmp1, iDir, bSubBlockOBMCSimp );
-          }
+  PelUnitBuf cPred = pcYuvPred   .subBuf( predArea );
+  PelUnitBuf cTmp1 = pcYuvTmpPred.subBuf( predArea );
 
-          //restore motion information
-          pu.cu->partSize  = ePartSize;
-          pu               = currMi;
-          pu.cu->affine    = bAffine;
-          pu.UnitArea::operator=( orgPuArea );
-        }
-      }
-    }
+  xSubBlockMotionCompensation( pu, cTmp1 );
+
+  if( bOBMC4ME )
+  {
+    xSubtractOBMC( pu, cPred, cTmp1, iDir, bOBMCSimp );
+  }
+  else
+  {
+    xSubblockOBMC( COMPONENT_Y,  pu, cPred, cTmp1, iDir, bOBMCSimp );
+    xSubblockOBMC( COMPONENT_Cb, pu, cPred, cTmp1, iDir, bOBMCSimp );
+    xSubblockOBMC( COMPONENT_Cr, pu, cPred, cTmp1, iDir, bOBMCSimp );
   }
+
+  //restore motion information
+  pu.cu->partSize  = ePartSize;
+  pu               = currMi;
+  pu.cu->affine    = bAffine;
+  pu.UnitArea::operator=( orgPuArea );
 }
 
 
@@ -1466,79 +1528,15 @@ Void InterPrediction::xSubblockOBMC(const ComponentID eComp, PredictionUnit &pu,
   PelBuf *pDst = &pcYuvPredDst.bufs[eComp];//.at(0, 0);
   PelBuf *pSrc = &pcYuvPredSrc.bufs[eComp];//.at(0, 0);
 
-  if( iDir == 0 ) //above
-  {
-    for( int i = 0; i < iWidth; i++ )
-    {
-      pDst->at( i, 0 ) = ( 3 * pDst->at( i, 0 ) + pSrc->at( i, 0 ) + 2 ) >> 2;
+  const Int numLines = eComp == COMPONENT_Y ? ( bOBMCSimp ? 2 : 4 ) : ( bOBMCSimp ? 1 : 2 );
 
-      if( !bOBMCSimp || eComp == COMPONENT_Y )
-      {
-        pDst->at( i, 1 ) = ( 7 * pDst->at( i, 1 ) + pSrc->at( i, 1 ) + 4 ) >> 3;
-      }
-
-      if( !bOBMCSimp && ( eComp == COMPONENT_Y ) )
-      {
-        pDst->at( i, 2 ) = ( 15 * pDst->at( i, 2 ) + pSrc->at( i, 2 ) +  8 ) >> 4;
-        pDst->at( i, 3 ) = ( 31 * pDst->at( i, 3 ) + pSrc->at( i, 3 ) + 16 ) >> 5;
-      }
-    }
-  }
-
-  if( iDir == 1 ) //left
+  switch( iDir )
   {
-    for( int i = 0; i < iHeight; i++ )
-    {
-      pDst->at( 0, i ) = ( 3 * pDst->at( 0, i ) + pSrc->at( 0, i ) + 2 ) >> 2;
-
-      if( !bOBMCSimp || eComp == COMPONENT_Y )
-      {
-        pDst->at( 1, i ) = ( 7 * pDst->at( 1, i ) + pSrc->at( 1, i ) + 4 ) >> 3;
-      }
-
-      if( !bOBMCSimp && ( eComp == COMPONENT_Y ) )
-      {
-        pDst->at( 2, i ) = ( 15 * pDst->at( 2, i ) + pSrc->at( 2, i ) +  8 ) >> 4;
-        pDst->at( 3, i ) = ( 31 * pDst->at( 3, i ) + pSrc->at( 3, i ) + 16 ) >> 5;
-      }
-    }
-  }
-
-  if( iDir == 2 ) //below
-  {
-    for( int i = 0; i < iWidth; i++ )
-    {
-      pDst->at( i, iHeight - 1 ) = ( 3 * pDst->at( i, iHeight - 1 ) + pSrc->at( i, iHeight - 1 ) + 2 ) >> 2;
-
-      if( !bOBMCSimp || eComp == COMPONENT_Y )
-      {
-        pDst->at( i, iHeight - 2 ) = ( 7 * pDst->at( i, iHeight - 2 ) + pSrc->at( i, iHeight - 2 ) + 4 ) >> 3;
-      }
-      if( !bOBMCSimp && ( eComp == COMPONENT_Y ) )
-      {
-        pDst->at( i, iHeight - 3 ) = ( 15 * pDst->at( i, iHeight - 3 ) + pSrc->at( i, iHeight - 3 ) +  8 ) >> 4;
-        pDst->at( i, iHeight - 4 ) = ( 31 * pDst->at( i, iHeight - 4 ) + pSrc->at( i, iHeight - 4 ) + 16 ) >> 5;
-      }
-    }
-  }
-
-  if( iDir == 3 ) //right
-  {
-    for( int i = 0; i < iHeight; i++ )
-    {
-      pDst->at( iWidth - 1, i ) = ( 3 * pDst->at( iWidth - 1, i ) + pSrc->at( iWidth - 1, i ) + 2 ) >> 2;
-
-      if( !bOBMCSimp || eComp == COMPONENT_Y )
-      {
-        pDst->at( iWidth - 2, i ) = ( 7 * pDst->at( iWidth - 2, i ) + pSrc->at( iWidth - 2, i ) + 4 ) >> 3;
-      }
-
-      if( !bOBMCSimp && ( eComp == COMPONENT_Y ) )
-      {
-        pDst->at( iWidth - 3, i ) = ( 15 * pDst->at( iWidth - 3, i ) + pSrc->at( iWidth - 3, i ) +  8 ) >> 4;
-        pDst->at( iWidth - 4, i ) = ( 31 * pDst->at( iWidth - 4, i ) + pSrc->at( iWidth - 4, i ) + 16 ) >> 5;
-      }
-    }
+  case 0: g_pelBufOP.obmcBlendHor( pDst->buf,                      pDst->stride, pSrc->buf,                      pSrc->stride, iWidth,  numLines,     false ); break; //above
+  case 1: g_pelBufOP.obmcBlendVer( pDst->buf,                      pDst->stride, pSrc->buf,                      pSrc->stride, iHeight, numLines,  1, false ); break; //left
+  case 2: g_pelBufOP.obmcBlendHor( &pDst->at( 0, iHeight - 1 ),   -pDst->stride, &pSrc->at( 0, iHeight - 1 ),   -pSrc->stride, iWidth,  numLines,     false ); break; //below
+  case 3: g_pelBufOP.obmcBlendVer( &pDst->at( iWidth - 1, 0 ),     pDst->stride, &pSrc->at( iWidth - 1, 0 ),     pSrc->stride, iHeight, numLines, -1, false ); break; //right
+  default: break;
   }
 }
 
@@ -1551,76 +1549,15 @@ Void InterPrediction::xSubtractOBMC( PredictionUnit &pu, PelUnitBuf &pcYuvPredDs
   PelBuf *pDst = &pcYuvPredDst.bufs[COMPONENT_Y];
   PelBuf *pSrc = &pcYuvPredSrc.bufs[COMPONENT_Y];
 
-  if( iDir == 0 ) //above
-  {
-    for( int i = 0; i < iWidth; i++ )
-    {
-      pDst->at( i, 0 ) += ( pDst->at( i, 0 ) - pSrc->at( i, 0 ) + 2 ) >> 2;
-      pDst->at( i, 1 ) += ( pDst->at( i, 1 ) - pSrc->at( i, 1 ) + 4 ) >> 3;
-    }
-
-    if( !bOBMCSimp )
-    {
-      for( int i = 0; i < iWidth; i++ )
-      {
-        pDst->at( i, 2 ) += ( pDst->at( i, 2 ) - pSrc->at( i, 2 ) +  8 ) >> 4;
-        pDst->at( i, 3 ) += ( pDst->at( i, 3 ) - pSrc->at( i, 3 ) + 16 ) >> 5;
-      }
-    }
-  }
+  const Int numLines = bOBMCSimp ? 2 : 4;
 
-  if( iDir == 1 ) //left
+  switch( iDir )
   {
-    for( int i = 0; i < iHeight; i++ )
-    {
-      pDst->at( 0, i ) += ( pDst->at( 0, i ) - pSrc->at( 0, i ) + 2 ) >> 2;
-      pDst->at( 1, i ) += ( pDst->at( 1, i ) - pSrc->at( 1, i ) + 4 ) >> 3;
-    }
-
-    if( !bOBMCSimp )
-    {
-      for( int i = 0; i < iHeight; i++ )
-      {
-        pDst->at( 2, i ) += ( pDst->at( 2, i ) - pSrc->at( 2, i ) +  8 ) >> 4;
-        pDst->at( 3, i ) += ( pDst->at( 3, i ) - pSrc->at( 3, i ) + 16 ) >> 5;
-      }
-    }
-  }
-
-  if( iDir == 2 ) //below
-  {
-    if( !bOBMCSimp )
-    {
-      for( int i = 0; i < iWidth; i++ )
-      {
-        pDst->at( i, iHeight - 4 ) += ( pDst->at( i, iHeight - 4 ) - pSrc->at( i, iHeight - 4 ) + 16 ) >> 5;
-        pDst->at( i, iHeight - 3 ) += ( pDst->at( i, iHeight - 3 ) - pSrc->at( i, iHeight - 3 ) +  8 ) >> 4;
-      }
-    }
-
-    for( int i = 0; i < iWidth; i++ )
-    {
-      pDst->at( i, iHeight - 2 ) += ( pDst->at( i, iHeight - 2 ) - pSrc->at( i, iHeight - 2 ) + 4 ) >> 3;
-      pDst->at( i, iHeight - 1 ) += ( pDst->at( i, iHeight - 1 ) - pSrc->at( i, iHeight - 1 ) + 2 ) >> 2;
-    }
-  }
-
-  if( iDir == 3 ) //right
-  {
-    if( !bOBMCSimp )
-    {
-      for( int i = 0; i < iHeight; i++ )
-      {
-        pDst->at( iWidth - 4, i ) += ( pDst->at( iWidth - 4, i ) - pSrc->at( iWidth - 4, i ) + 16 ) >> 5;
-        pDst->at( iWidth - 3, i ) += ( pDst->at( iWidth - 3, i ) - pSrc->at( iWidth - 3, i ) +  8 ) >> 4;
-      }
-    }
-
-    for( int i = 0; i < iHeight; i++ )
-    {
-      pDst->at( iWidth - 2, i ) += ( pDst->at( iWidth - 2, i ) - pSrc->at( iWidth - 2, i ) + 4 ) >> 3;
-      pDst->at( iWidth - 1, i ) += ( pDst->at( iWidth - 1, i ) - pSrc->at( iWidth - 1, i ) + 2 ) >> 2;
-    }
+  case 0: g_pelBufOP.obmcBlendHor( pDst->buf,                      pDst->stride, pSrc->buf,                      pSrc->stride, iWidth,  numLines,     true ); break; //above
+  case 1: g_pelBufOP.obmcBlendVer( pDst->buf,                      pDst->stride, pSrc->buf,                      pSrc->stride, iHeight, numLines,  1, true ); break; //left
+  case 2: g_pelBufOP.obmcBlendHor( &pDst->at( 0, iHeight - 1 ),   -pDst->stride, &pSrc->at( 0, iHeight - 1 ),   -pSrc->stride, iWidth,  numLines,     true ); break; //below
+  case 3: g_pelBufOP.obmcBlendVer( &pDst->at( iWidth - 1, 0 ),     pDst->stride, &pSrc->at( iWidth - 1, 0 ),     pSrc->stride, iHeight, numLines, -1, true ); break; //right
+  default: break;
   }
 }
 #endif
@@ -1640,67 +1577,6 @@ Void InterPrediction::xSubBlockMotionCompensation( PredictionUnit &pu, PelUnitBu
 #endif
 
 #if JEM_TOOLS
-Void InterPrediction::xGradFilterX( const Pel* piRefY, Int iRefStride, Pel* piDstY, Int iDstStride, Int iWidth, Int iHeight, Int iMVyFrac, Int iMVxFrac, const Int bitDepth )
-{
-  static const int iBIOGradShift = 4;
-  if( iMVyFrac == 0 )
-  {
-    gradFilter1DHor( piRefY, iRefStride,  iWidth, iHeight, iDstStride,  piDstY, iMVxFrac, iBIOGradShift );
-    return;
-  }
-
-  int   tmpStride = iWidth + BIO_FILTER_LENGTH_MINUS_1;
-  Pel*  tmp       = m_filteredBlockTmp[0][0];
-  int   shift0    = bitDepth-8;
-  int   shift1    = 6 + iBIOGradShift - shift0;
-  fracFilter2DVer ( piRefY - BIO_FILTER_HALF_LENGTH_MINUS_1, iRefStride, iWidth+BIO_FILTER_LENGTH_MINUS_1, iHeight, tmpStride,  tmp,    iMVyFrac, shift0 );
-  JVET_J0090_SET_CACHE_ENABLE( false );
-  gradFilter2DHor ( tmp    + BIO_FILTER_HALF_LENGTH_MINUS_1, tmpStride,  iWidth,                           iHeight, iDstStride, piDstY, iMVxFrac, shift1 );
-  JVET_J0090_SET_CACHE_ENABLE( true );
-}
-
-Void InterPrediction::xGradFilterY( const Pel* piRefY, Int iRefStride, Pel* piDstY, Int iDstStride, Int iWidth, Int iHeight, Int iMVyFrac, Int iMVxFrac, const Int bitDepth )
-{
-  static const Int iBIOGradShift = 4;
-  if( iMVxFrac == 0 )
-  {
-    gradFilter1DVer( piRefY, iRefStride, iWidth, iHeight, iDstStride, piDstY, iMVyFrac, iBIOGradShift );
-    return;
-  }
-
-  Int   tmpStride = iWidth + BIO_FILTER_LENGTH_MINUS_1;
-  Pel*  tmp       = m_filteredBlockTmp[0][0];
-  Int   shift0    = bitDepth-8;
-  Int   shift1    = 6 + iBIOGradShift - shift0;
-  gradFilter2DVer ( piRefY - BIO_FILTER_HALF_LENGTH_MINUS_1, iRefStride, iWidth+BIO_FILTER_LENGTH_MINUS_1, iHeight, tmpStride,  tmp,    iMVyFrac, shift0 );
-  JVET_J0090_SET_CACHE_ENABLE( false );
-  fracFilter2DHor ( tmp    + BIO_FILTER_HALF_LENGTH_MINUS_1, tmpStride,  iWidth,                           iHeight, iDstStride, piDstY, iMVxFrac, shift1 );
-  JVET_J0090_SET_CACHE_ENABLE( true );
-}
-
-Pel InterPrediction::optical_flow_averaging( Int64 s1, Int64 s2, Int64 s3, Int64 s5, Int64 s6, Pel pGradX0, Pel pGradX1, Pel pGradY0, Pel pGradY1, Pel pSrcY0Temp, Pel pSrcY1Temp,
-                                             const int shiftNum, const int offset, const Int64 limit, const Int64 denom_min_1, const Int64 denom_min_2, const ClpRng& clpRng )
-{
-  Int64 vx = 0;
-  Int64 vy = 0;
-  Int64 b=0;
-
-  if( s1 > denom_min_1 )
-  {
-    vx = s3  / s1;
-    vx = ( vx > limit ? limit : vx < -limit ? -limit : vx );
-  }
-  if( s5 > denom_min_2 )
-  {
-    vy = ( s6 - vx*s2 ) / s5;
-    vy = ( vy > limit ? limit : vy < -limit ? -limit : vy );
-  }
-
-  b = vx * ( pGradX0 - pGradX1 ) + vy * ( pGradY0 - pGradY1 );
-  b = ( b > 0 ? (b+32)>>6 : -((-b+32)>>6) );
-  return ClipPel( (Short)((pSrcY0Temp + pSrcY1Temp + b + offset) >> shiftNum), clpRng );
-}
-
 const Short m_lumaGradientFilter[4<<VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE][BIO_FILTER_LENGTH] =
 {
   {       8,     -39,      -3,      46,     -17,       5 },   //0
@@ -1741,251 +1617,69 @@ const Short m_lumaInterpolationFilter[4<<VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STOR
   {       0,      -2,       4,      64,      -3,       1 }    //15-->-->
 };
 
-inline Void InterPrediction::gradFilter2DVer( const Pel* piSrc, Int iSrcStride,  Int width, Int height, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift )
+Void InterPrediction::xGradFilterX( const Pel* piRefY, Int iRefStride, Pel* piDstY, Int iDstStride, Int iWidth, Int iHeight, Int iMVyFrac, Int iMVxFrac, const Int bitDepth )
 {
-  Pel*        piDst         = rpiDst;
-  int         iSum          = 0;
-  const Pel*  piSrcTmp      = piSrc - BIO_FILTER_HALF_LENGTH_MINUS_1 * iSrcStride;
-  const Pel*  piSrcTmp1     = piSrcTmp  + iSrcStride;
-  const Pel*  piSrcTmp2     = piSrcTmp1 + iSrcStride;
-  const Pel*  piSrcTmp3     = piSrcTmp2 + iSrcStride;
-  const Pel*  piSrcTmp4     = piSrcTmp3 + iSrcStride;
-  const Pel*  piSrcTmp5     = piSrcTmp4 + iSrcStride;
-  const Short *const coeffs = m_lumaGradientFilter[iMV];
-
-  const int   iOffSet       = ( iShift > 0 ? ( 1 << ( iShift - 1 ) ) : 0 );
-
-  iSrcStride               -= width;
-  iDstStride               -= width;
-
-  for( int y = 0; y < height; y++ )
-  {
-    for( int x = 0; x < width; x++ )
-    {
-      JVET_J0090_CACHE_ACCESS( piSrcTmp,  __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp1, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp2, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp3, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp4, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp5, __FILE__, __LINE__ );
-      iSum     =  (  coeffs[0] * *piSrcTmp++
-                   + coeffs[1] * *piSrcTmp1++
-                   + coeffs[2] * *piSrcTmp2++
-                   + coeffs[3] * *piSrcTmp3++
-                   + coeffs[4] * *piSrcTmp4++
-                   + coeffs[5] * *piSrcTmp5++ );
-      iSum     = ( iSum >= 0 ? ( iSum + iOffSet ) >> iShift : -( ( -iSum + iOffSet ) >> iShift ) );
-      *piDst++ = ( Pel ) iSum;
-    }
-
-    piSrcTmp  += iSrcStride;
-    piSrcTmp1 += iSrcStride;
-    piSrcTmp2 += iSrcStride;
-    piSrcTmp3 += iSrcStride;
-    piSrcTmp4 += iSrcStride;
-    piSrcTmp5 += iSrcStride;
-    piDst     += iDstStride;
+  static const int iBIOGradShift = 4;
+  if( iMVyFrac == 0 )
+  {
+    m_if.m_filterBio[0]( piRefY, iRefStride, piDstY, iDstStride, iWidth, iHeight, m_lumaGradientFilter[iMVxFrac], iBIOGradShift, 1 << ( iBIOGradShift - 1 ) );
+    return;
   }
-}
 
-inline Void InterPrediction::gradFilter1DVer( const Pel* piSrc, Int iSrcStride, Int width, Int height, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift )
-{
-  Pel*        piDst         = rpiDst;
-  int         iSum          = 0;
-  const Pel*  piSrcTmp      = piSrc - BIO_FILTER_HALF_LENGTH_MINUS_1 * iSrcStride;
-  const Pel*  piSrcTmp1     = piSrcTmp  + iSrcStride;
-  const Pel*  piSrcTmp2     = piSrcTmp1 + iSrcStride;
-  const Pel*  piSrcTmp3     = piSrcTmp2 + iSrcStride;
-  const Pel*  piSrcTmp4     = piSrcTmp3 + iSrcStride;
-  const Pel*  piSrcTmp5     = piSrcTmp4 + iSrcStride;
-  const Short *const coeffs = m_lumaGradientFilter[iMV];
-
-  const int   iOffSet       = 1 << ( iShift - 1 );
-
-  iSrcStride               -= width;
-  iDstStride               -= width;
-
-  for( int y = 0; y < height; y++ )
-  {
-    for( int x = 0; x < width; x++ )
-    {
-      JVET_J0090_CACHE_ACCESS( piSrcTmp,  __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp1, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp2, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp3, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp4, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp5, __FILE__, __LINE__ );
-      iSum     =   (  coeffs[0] * *piSrcTmp++
-                    + coeffs[1] * *piSrcTmp1++
-                    + coeffs[2] * *piSrcTmp2++
-                    + coeffs[3] * *piSrcTmp3++
-                    + coeffs[4] * *piSrcTmp4++
-                    + coeffs[5] * *piSrcTmp5++ );
-      iSum     = ( iSum >= 0 ? ( iSum + iOffSet ) >> iShift : -( ( -iSum + iOffSet ) >> iShift ) );
-      *piDst++ = ( Pel ) iSum;
-    }
-
-    piSrcTmp  += iSrcStride;
-    piSrcTmp1 += iSrcStride;
-    piSrcTmp2 += iSrcStride;
-    piSrcTmp3 += iSrcStride;
-    piSrcTmp4 += iSrcStride;
-    piSrcTmp5 += iSrcStride;
-    piDst     += iDstStride;
-  }
+  int   tmpStride = iWidth + BIO_FILTER_LENGTH_MINUS_1;
+  Pel*  tmp       = m_filteredBlockTmp[0][0];
+  int   shift0    = bitDepth-8;
+  int   shift1    = 6 + iBIOGradShift - shift0;
+  int   offset0   = ( shift0 > 0 ? ( 1 << ( shift0 - 1 ) ) - ( 8192 << shift0 ) : -8192 );
+  int   offset1   = ( shift1 > 0 ? 1 << ( shift1 - 1 ) : 0 );
+  m_if.m_filterBio[1]( piRefY - BIO_FILTER_HALF_LENGTH_MINUS_1, iRefStride, tmp,    tmpStride,  iWidth+BIO_FILTER_LENGTH_MINUS_1, iHeight, m_lumaInterpolationFilter[iMVyFrac], shift0, offset0 );
+  JVET_J0090_SET_CACHE_ENABLE( false );
+  m_if.m_filterBio[0]( tmp    + BIO_FILTER_HALF_LENGTH_MINUS_1, tmpStride,  piDstY, iDstStride, iWidth,                           iHeight, m_lumaGradientFilter     [iMVxFrac], shift1, offset1 );
+  JVET_J0090_SET_CACHE_ENABLE( true );
 }
 
-inline Void InterPrediction::gradFilter1DHor( const Pel* piSrc, Int iSrcStride, Int width, Int height, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift )
+Void InterPrediction::xGradFilterY( const Pel* piRefY, Int iRefStride, Pel* piDstY, Int iDstStride, Int iWidth, Int iHeight, Int iMVyFrac, Int iMVxFrac, const Int bitDepth )
 {
-  Pel*        piDst         = rpiDst;
-  int         iSum          = 0;
-  const Pel*  piSrcTmp      = piSrc - BIO_FILTER_HALF_LENGTH_MINUS_1;
-  const int   iOffSet       = 1 << ( iShift - 1 );
-  const Short *const coeffs = m_lumaGradientFilter[iMV];
-
-  iSrcStride               -= width;
-  iDstStride               -= width;
-
-  for( int y = 0; y < height; y++ )
+  static const Int iBIOGradShift = 4;
+  if( iMVxFrac == 0 )
   {
-    for( int x = 0; x < width; x++ )
-    {
-      for ( size_t i = 0 ; i < 6 ; i++ )
-      {
-        JVET_J0090_CACHE_ACCESS( piSrcTmp + i, __FILE__, __LINE__ );
-      }
-      iSum     =  (  coeffs[0] * piSrcTmp[0]
-                   + coeffs[1] * piSrcTmp[1]
-                   + coeffs[2] * piSrcTmp[2]
-                   + coeffs[3] * piSrcTmp[3]
-                   + coeffs[4] * piSrcTmp[4]
-                   + coeffs[5] * piSrcTmp[5] );
-      iSum     = ( iSum >= 0 ? ( iSum + iOffSet ) >> iShift : -( ( -iSum + iOffSet ) >> iShift ) );
-      *piDst++ = ( Pel ) iSum;
-
-      piSrcTmp++;
-    }
-
-    piSrcTmp += iSrcStride;
-    piDst    += iDstStride;
+    m_if.m_filterBio[1]( piRefY, iRefStride, piDstY, iDstStride, iWidth, iHeight, m_lumaGradientFilter[iMVyFrac], iBIOGradShift, 1 << ( iBIOGradShift - 1 ) );
+    return;
   }
+
+  Int   tmpStride = iWidth + BIO_FILTER_LENGTH_MINUS_1;
+  Pel*  tmp       = m_filteredBlockTmp[0][0];
+  Int   shift0    = bitDepth-8;
+  Int   shift1    = 6 + iBIOGradShift - shift0;
+  Int   offset0   = ( shift0 > 0 ? 1 << ( shift0 - 1 ) : 0 );
+  Int   offset1   = ( shift1 > 0 ? 1 << ( shift1 - 1 ) : 0 );
+  m_if.m_filterBio[1]( piRefY - BIO_FILTER_HALF_LENGTH_MINUS_1, iRefStride, tmp,    tmpStride,  iWidth+BIO_FILTER_LENGTH_MINUS_1, iHeight, m_lumaGradientFilter     [iMVyFrac], shift0, offset0 );
+  JVET_J0090_SET_CACHE_ENABLE( false );
+  m_if.m_filterBio[0]( tmp    + BIO_FILTER_HALF_LENGTH_MINUS_1, tmpStride,  piDstY, iDstStride, iWidth,                           iHeight, m_lumaInterpolationFilter[iMVxFrac], shift1, offset1 );
+  JVET_J0090_SET_CACHE_ENABLE( true );
 }
 
-inline Void InterPrediction::gradFilter2DHor( const Pel* piSrc, Int iSrcStride, Int width, Int height, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift)
+Pel InterPrediction::optical_flow_averaging( Int64 s1, Int64 s2, Int64 s3, Int64 s5, Int64 s6, Pel pGradX0, Pel pGradX1, Pel pGradY0, Pel pGradY1, Pel pSrcY0Temp, Pel pSrcY1Temp,
+                                             const int shiftNum, const int offset, const Int64 limit, const Int64 denom_min_1, const Int64 denom_min_2, const ClpRng& clpRng )
 {
-  Pel*        piDst         = rpiDst;
-  Int         iSum          = 0;
-  const Pel*  piSrcTmp      = piSrc - BIO_FILTER_HALF_LENGTH_MINUS_1;
-  const Int   iOffSet       = ( iShift > 0 ? 1 << ( iShift - 1 ) : 0 );
-  const Short *const coeffs = m_lumaGradientFilter[iMV];
-
-  iSrcStride               -= width;
-  iDstStride               -= width;
+  Int64 vx = 0;
+  Int64 vy = 0;
+  Int64 b=0;
 
-  for( int y = 0; y < height; y++ )
+  if( s1 > denom_min_1 )
   {
-    for( int x = 0; x < width; x++ )
-    {
-      for ( size_t i = 0 ; i < 6 ; i++ )
-      {
-        JVET_J0090_CACHE_ACCESS( piSrcTmp + i, __FILE__, __LINE__ );
-      }
-      iSum     =   (  coeffs[0] * piSrcTmp[0]
-                    + coeffs[1] * piSrcTmp[1]
-                    + coeffs[2] * piSrcTmp[2]
-                    + coeffs[3] * piSrcTmp[3]
-                    + coeffs[4] * piSrcTmp[4]
-                    + coeffs[5] * piSrcTmp[5] );
-      iSum     = ( iSum >= 0 ? ( iSum + iOffSet ) >> iShift : -( ( -iSum + iOffSet ) >> iShift ) );
-      *piDst++ = ( Pel ) iSum;
-
-      piSrcTmp++;
-    }
-
-    piSrcTmp += iSrcStride;
-    piDst    += iDstStride;
-  }
-}
-
-inline Void InterPrediction::fracFilter2DVer( const Pel* piSrc, Int iSrcStride, Int width, Int height, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift )
-{
-  Pel*        piDst         = rpiDst;
-  int         iSum          = 0;
-  const Pel*  piSrcTmp      = piSrc - BIO_FILTER_HALF_LENGTH_MINUS_1 * iSrcStride;
-  const Pel*  piSrcTmp1     = piSrcTmp  + iSrcStride;
-  const Pel*  piSrcTmp2     = piSrcTmp1 + iSrcStride;
-  const Pel*  piSrcTmp3     = piSrcTmp2 + iSrcStride;
-  const Pel*  piSrcTmp4     = piSrcTmp3 + iSrcStride;
-  const Pel*  piSrcTmp5     = piSrcTmp4 + iSrcStride;
-  const int   iOffSet       = ( iShift > 0 ? ( 1 << ( iShift - 1 ) ) - ( 8192 << iShift ) : -8192 );
-  const Short *const coeffs = m_lumaInterpolationFilter[iMV];
-
-  iSrcStride               -= width;
-  iDstStride               -= width;
-
-  for( int y = 0; y < height; y++ )
-  {
-    for( int x = 0; x < width; x++ )
-    {
-      JVET_J0090_CACHE_ACCESS( piSrcTmp,  __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp1, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp2, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp3, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp4, __FILE__, __LINE__ );
-      JVET_J0090_CACHE_ACCESS( piSrcTmp5, __FILE__, __LINE__ );
-      iSum     =  (  coeffs[0] * *piSrcTmp ++
-                   + coeffs[1] * *piSrcTmp1++
-                   + coeffs[2] * *piSrcTmp2++
-                   + coeffs[3] * *piSrcTmp3++
-                   + coeffs[4] * *piSrcTmp4++
-                   + coeffs[5] * *piSrcTmp5++ );
-      iSum     = ( iSum >= 0 ? ( iSum + iOffSet ) >> iShift : -( ( -iSum + iOffSet ) >> iShift ) );
-      *piDst++ = ( Pel ) iSum;
-    }
-
-    piSrcTmp  += iSrcStride;
-    piSrcTmp1 += iSrcStride;
-    piSrcTmp2 += iSrcStride;
-    piSrcTmp3 += iSrcStride;
-    piSrcTmp4 += iSrcStride;
-    piSrcTmp5 += iSrcStride;
-    piDst     += iDstStride;
+    vx = s3  / s1;
+    vx = ( vx > limit ? limit : vx < -limit ? -limit : vx );
   }
-}
-
-inline Void InterPrediction::fracFilter2DHor( const Pel* piSrc, Int iSrcStride, Int width, Int height, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift )
-{
-  Pel*        piDst         = rpiDst;
-  int         iSum          = 0;
-  const Pel*  piSrcTmp      = piSrc - BIO_FILTER_HALF_LENGTH_MINUS_1;
-  const int   iOffSet       = ( iShift > 0 ? 1 << ( iShift - 1 ) : 0 );
-  const Short *const coeffs = m_lumaInterpolationFilter[iMV];
-
-  iSrcStride               -= width;
-  iDstStride               -= width;
-
-  for( int y = 0; y < height; y++ )
+  if( s5 > denom_min_2 )
   {
-    for( int x = 0; x < width; x++ )
-    {
-      for ( size_t i = 0 ; i < 6 ; i++ )
-      {
-        JVET_J0090_CACHE_ACCESS( piSrcTmp + i, __FILE__, __LINE__ );
-      }
-      iSum     = (  coeffs[0] * piSrcTmp[0]
-                  + coeffs[1] * piSrcTmp[1]
-                  + coeffs[2] * piSrcTmp[2]
-                  + coeffs[3] * piSrcTmp[3]
-                  + coeffs[4] * piSrcTmp[4]
-                  + coeffs[5] * piSrcTmp[5] );
-      iSum     = ( iSum >= 0 ? ( iSum + iOffSet ) >> iShift : -( ( -iSum + iOffSet ) >> iShift ) );
-      *piDst++ = ( Pel ) iSum;
-      piSrcTmp++;
-    }
-
-    piSrcTmp += iSrcStride;
-    piDst    += iDstStride;
+    vy = ( s6 - vx*s2 ) / s5;
+    vy = ( vy > limit ? limit : vy < -limit ? -limit : vy );
   }
+
+  b = vx * ( pGradX0 - pGradX1 ) + vy * ( pGradY0 - pGradY1 );
+  b = ( b > 0 ? (b+32)>>6 : -((-b+32)>>6) );
+  return ClipPel( (Short)((pSrcY0Temp + pSrcY1Temp + b + offset) >> shiftNum), clpRng );
 }
 
 inline Int GetMSB64( UInt64 x )
@@ -2050,70 +1744,70 @@ inline Int64 InterPrediction::divide64( Int64 numer, Int64 denom )
   return d;
 }
 
-Void InterPrediction::calcBlkGradient( Int sx, Int sy, Int64 *arraysGx2, Int64 *arraysGxGy, Int64 *arraysGxdI, Int64 *arraysGy2, Int64 *arraysGydI, Int64 &sGx2, Int64 &sGy2, Int64 &sGxGy, Int64 &sGxdI, Int64 &sGydI, Int iWidth, Int iHeight )
-{
-  static const UInt weightTbl[8][8] = { {1, 2, 3, 4, 4, 3, 2, 1},
-      {2, 4, 6, 8, 8, 6, 4, 2},
-      {3, 6, 9, 12, 12, 9, 6, 3},
-      {4, 8, 12, 16, 16, 12, 8, 4},
-      {4, 8, 12, 16, 16, 12, 8, 4},
-      {3, 6, 9, 12, 12, 9, 6, 3},
-      {2, 4, 6, 8, 8, 6, 4, 2},
-      {1, 2, 3, 4, 4, 3, 2, 1 } };
-
-  Int64 *pGx2 = arraysGx2;
-  Int64 *pGy2 = arraysGy2;
-  Int64 *pGxGy = arraysGxGy;
-  Int64 *pGxdI = arraysGxdI;
-  Int64 *pGydI = arraysGydI;
-
-  Int x0;
-
-  if (sy > 0 && iHeight > 4)
-  {
-    pGx2 -= (iWidth << 1);
-    pGy2 -= (iWidth << 1);
-    pGxGy -= (iWidth << 1);
-    pGxdI -= (iWidth << 1);
-    pGydI -= (iWidth << 1);
-  }
+static const Int FRUC_MERGE_MV_SEARCHPATTERN_CROSS    = 0;
+static const Int FRUC_MERGE_MV_SEARCHPATTERN_SQUARE   = 1;
+static const Int FRUC_MERGE_MV_SEARCHPATTERN_DIAMOND  = 2;
+static const Int FRUC_MERGE_MV_SEARCHPATTERN_HEXAGON  = 3;
 
-  for (Int y = -2; y < 6; y++)
+Void InterPrediction::xFrucResetCostCache()
+{
+  if( ++m_frucCostCacheGen == 0 )
   {
-    for (Int x = -2; x < 6; x++)
+    for( Int i = 0; i < FRUC_COST_CACHE_SIZE; i++ )
     {
-      UInt weight = weightTbl[y + 2][x + 2];
-      x0 = x;
-      if (sx + x < 0)       x0 = 0;
-      if (sx + x >= iWidth) x0 = 3;
-
-      sGx2 += weight*pGx2[x0];
-      sGy2 += weight*pGy2[x0];
-      sGxGy += weight*pGxGy[x0];
-      sGxdI += weight*pGxdI[x0];
-      sGydI += weight*pGydI[x0];
-    }
-
-    if (sy + y < 0 || sy + y >= iHeight - 1)
-    {
-      continue;
+      m_frucCostCache[i].generation = 0;
     }
-
-    pGx2 += iWidth;
-    pGy2 += iWidth;
-    pGxGy += iWidth;
-    pGxdI += iWidth;
-    pGydI += iWidth;
+    m_frucCostCacheGen = 1;
   }
 }
 
-static const Int FRUC_MERGE_MV_SEARCHPATTERN_CROSS    = 0;
-static const Int FRUC_MERGE_MV_SEARCHPATTERN_SQUARE   = 1;
-static const Int FRUC_MERGE_MV_SEARCHPATTERN_DIAMOND  = 2;
-static const Int FRUC_MERGE_MV_SEARCHPATTERN_HEXAGON  = 3;
+// Returns the cache entry of a candidate. On a miss the entry is prepared for the candidate but stays invalid until
+// the caller stores the distortion and sets the generation.
+FrucMatchCost& InterPrediction::xFrucGetCostCacheEntry( const PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField, Bool bTM, Bool& rbHit )
+{
+  const Mv   &mv   = rCurMvField.mv;
+  const UInt  hash = ( UInt( mv.hor ) * 0x9E3779B1u ) ^ ( UInt( mv.ver ) * 0x85EBCA77u ) ^ ( UInt( 2 * rCurMvField.refIdx + eCurRefPicList ) * 0xC2B2AE3Du );
+
+  FrucMatchCost &entry = m_frucCostCache[hash >> ( 32 - FRUC_COST_CACHE_LOG2 )];
+
+  rbHit = entry.generation == m_frucCostCacheGen
+       && entry.pos        == pu.lumaPos()
+       && entry.width      == nWidth
+       && entry.height     == nHeight
+       && entry.refList    == eCurRefPicList
+       && entry.refIdx     == rCurMvField.refIdx
+       && entry.hor        == mv.hor
+       && entry.ver        == mv.ver
+       && entry.highPrec   == mv.highPrec
+       && entry.bTM        == bTM;
+
+  if( !rbHit )
+  {
+    entry.generation = 0;
+    entry.pos        = pu.lumaPos();
+    entry.width      = nWidth;
+    entry.height     = nHeight;
+    entry.refList    = eCurRefPicList;
+    entry.refIdx     = rCurMvField.refIdx;
+    entry.hor        = mv.hor;
+    entry.ver        = mv.ver;
+    entry.highPrec   = mv.highPrec;
+    entry.bTM        = bTM;
+  }
+
+  return entry;
+}
 
-UInt InterPrediction::xFrucGetTempMatchCost( PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField, UInt uiMVCost )
+UInt InterPrediction::xFrucGetTempMatchCost( PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField, UInt uiMVCost, UInt uiMaxCost )
 {
+  Bool bCached = false;
+  FrucMatchCost &cache = xFrucGetCostCacheEntry( pu, nWidth, nHeight, eCurRefPicList, rCurMvField, true, bCached );
+
+  if( bCached )
+  {
+    return cache.dist + uiMVCost;
+  }
+
   const Int nMVUnit = 2;
 
   UInt uiCost = uiMVCost;
@@ -2149,6 +1843,12 @@ UInt InterPrediction::xFrucGetTempMatchCost( PredictionUnit& pu, Int nWidth, Int
 
   if( m_bFrucTemplateAvailabe[1] )
   {
+    if( uiCost >= uiMaxCost && uiMVCost != MAX_UINT )
+    {
+      // the candidate can not win anymore, skip the left template (the partial cost is not cached)
+      return uiCost;
+    }
+
     Mv mvLeft( - ( FRUC_MERGE_TEMPLATE_SIZE << nMVUnit ) , 0 );
     if( pu.cs->sps->getSpsNext().getUseHighPrecMv() )
     {
@@ -2170,11 +1870,23 @@ UInt InterPrediction::xFrucGetTempMatchCost( PredictionUnit& pu, Int nWidth, Int
     uiCost += cDistParam.distFunc( cDistParam ); //TODO: check distFunc
   }
 
+  cache.dist       = uiCost - uiMVCost;
+  cache.generation = m_frucCostCacheGen;
+
   return uiCost;
 }
 
 UInt InterPrediction::xFrucGetBilaMatchCost( PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField, MvField& rPairMVField, UInt uiMVCost )
 {
+  Bool bCached = false;
+  FrucMatchCost &cache = xFrucGetCostCacheEntry( pu, nWidth, nHeight, eCurRefPicList, rCurMvField, false, bCached );
+
+  if( bCached )
+  {
+    rPairMVField = cache.pairMvField;
+    return cache.dist == MAX_UINT ? MAX_UINT : cache.dist + uiMVCost;
+  }
+
   UInt uiCost = MAX_UINT;
 
   if( PU::getMvPair( pu, eCurRefPicList , rCurMvField , rPairMVField ) )
@@ -2202,22 +1914,38 @@ UInt InterPrediction::xFrucGetBilaMatchCost( PredictionUnit& pu, Int nWidth, Int
     uiCost = cDistParam.distFunc( cDistParam )  + uiMVCost; //TODO: check distFunc
   }
 
+  cache.dist        = uiCost == MAX_UINT ? MAX_UINT : uiCost - uiMVCost;
+  cache.pairMvField = rPairMVField;
+  cache.generation  = m_frucCostCacheGen;
+
   return uiCost;
 }
 
-Bool InterPrediction::xFrucIsInList( const MvField & rMvField , std::list<MvField> & rList )
+static inline UInt64 xFrucGetMvHashBit( const MvField & rMvField )
 {
-  std::list<MvField>::iterator pos = rList.begin();
-  while( pos != rList.end() )
+  // hash the high precision representation to stay consistent with Mv::operator==
+  const Int  shift = rMvField.mv.highPrec ? 0 : VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE;
+  const UInt hash  = ( ( UInt( rMvField.mv.hor ) << shift ) * 0x9E3779B1u ) ^ ( ( UInt( rMvField.mv.ver ) << shift ) * 0x85EBCA77u ) ^ ( UInt( rMvField.refIdx ) * 0xC2B2AE3Du );
+
+  return UInt64( 1 ) << ( hash >> 26 );
+}
+
+Bool InterPrediction::xFrucIsInList( const MvField & rMvField , const FrucMvList & rList )
+{
+  if( !( rList.hashMask & xFrucGetMvHashBit( rMvField ) ) )
+  {
+    return( false );
+  }
+
+  for( const auto &mvField : rList.mvField )
   {
-    if( rMvField == *pos )
+    if( rMvField == mvField )
       return( true );
-    pos++;
   }
   return( false );
 }
 
-Void InterPrediction::xFrucInsertMv2StartList( const MvField & rMvField , std::list<MvField> & rList, Bool setHighPrec )
+Void InterPrediction::xFrucInsertMv2StartList( const MvField & rMvField , FrucMvList & rList, Bool setHighPrec )
 {
   CHECK( rMvField.refIdx < 0, "invalid ref idx" );
 
@@ -2229,7 +1957,10 @@ Void InterPrediction::xFrucInsertMv2StartList( const MvField & rMvField , std::l
 
   // do not use zoom in FRUC for now
   if( xFrucIsInList( mf , rList ) == false )
-    rList.push_back( mf );
+  {
+    rList.mvField.push_back( mf );
+    rList.hashMask |= xFrucGetMvHashBit( mf );
+  }
 }
 
 Void InterPrediction::xFrucCollectBlkStartMv( PredictionUnit& pu, const MergeCtx& mergeCtx, RefPicList eTargetRefList, Int nTargetRefIdx, AMVPInfo* pInfo )
@@ -2350,7 +2081,7 @@ Void InterPrediction::xFrucCollectBlkStartMv( PredictionUnit& pu, const MergeCtx
 
 Void InterPrediction::xFrucCollectSubBlkStartMv( PredictionUnit& pu, const MergeCtx& mergeCtx, RefPicList eRefPicList , const MvField& rMvStart , Int nSubBlkWidth , Int nSubBlkHeight, Position basePuPos )
 {
-  std::list<MvField> & rStartMvList = m_listMVFieldCand[eRefPicList];
+  FrucMvList & rStartMvList = m_listMVFieldCand[eRefPicList];
   rStartMvList.clear();
 
   // start Mv
@@ -2419,25 +2150,20 @@ Void InterPrediction::xFrucCollectSubBlkStartMv( PredictionUnit& pu, const Merge
       MvField mvCand;
       const Picture* pColPic  = pu.cs->slice->getRefPic( eRefPicList, nRefIdx );
 
-      const unsigned scale = ( pu.cs->pcv->noMotComp ? 1 : 4 * std::max<Int>(1, 4 * AMVP_DECIMATION_FACTOR / 4) );
-
-      const unsigned mask  = ~( scale - 1 );
-
       Int x_off = n == 0 ? 0 : nSubBlkWidth;
       Int y_off = n == 0 ? 0 : nSubBlkHeight;
 
-      Position _pos = Position{ pu.lumaPos().x + x_off, pu.lumaPos().y + y_off };
-
-      const Position pos = Position{ PosType( _pos.x & mask ), PosType( _pos.y & mask ) };
+      const Position pos = Position{ pu.lumaPos().x + x_off, pu.lumaPos().y + y_off };
 
-      const MotionInfo &colMi = pColPic->cs->getMotionInfo( pos );
+      const ColMotionField &colMotion = pColPic->cs->getColMotion();
+      const unsigned        colIdx    = colMotion.idx( pos );
 
       for( Int nRefListColPic = 0; nRefListColPic < 2; nRefListColPic++ )
       {
-        if( colMi.interDir & ( 1 << nRefListColPic ) ) // TODO: check if refIdx is always NOT_VALID, not 0 as set
+        if( colMotion.interDir( colIdx ) & ( 1 << nRefListColPic ) ) // TODO: check if refIdx is always NOT_VALID, not 0 as set
         {
-          CHECK( colMi.isInter == false, "invalid motion info" );
-          Mv rColMv = colMi.mv[nRefListColPic];
+          CHECK( !colMotion.isInter( colIdx ), "invalid motion info" );
+          Mv rColMv = colMotion.mv[nRefListColPic][colIdx];
 
           if( pu.cs->sps->getSpsNext().getUseHighPrecMv() )
           {
@@ -2445,7 +2171,7 @@ Void InterPrediction::xFrucCollectSubBlkStartMv( PredictionUnit& pu, const Merge
           }
 
           mvCand.refIdx = rMvStart.refIdx;
-          mvCand.mv     = PU::scaleMv( rColMv , nCurPOC , nCurRefPOC , pColPic->getPOC(), pColPic->cs->slice->getRefPOC( ( RefPicList )nRefListColPic , colMi.refIdx[nRefListColPic] ), pu.cs->slice );
+          mvCand.mv     = PU::scaleMv( rColMv , nCurPOC , nCurRefPOC , pColPic->getPOC(), pColPic->cs->slice->getRefPOC( ( RefPicList )nRefListColPic , colMotion.refIdx[nRefListColPic][colIdx] ), pu.cs->slice );
           if( mvCand.refIdx < 0 )
           {
             printf( "base" );
@@ -2499,7 +2225,7 @@ UInt InterPrediction::xFrucFindBestMvFromList( MvField* pBestMvField, RefPicList
   for( Int nRefPicList = nRefPicListStart ; nRefPicList <= nRefPicListEnd ; nRefPicList++ )
   {
     RefPicList eCurRefPicList = ( RefPicList )nRefPicList;
-    for( std::list<MvField>::iterator pos = m_listMVFieldCand[eCurRefPicList].begin() ; pos != m_listMVFieldCand[eCurRefPicList].end() ; pos++ )
+    for( auto pos = m_listMVFieldCand[eCurRefPicList].mvField.begin() ; pos != m_listMVFieldCand[eCurRefPicList].mvField.end() ; pos++ )
     {
       MvField mvPair;
 
@@ -2521,7 +2247,7 @@ UInt InterPrediction::xFrucFindBestMvFromList( MvField* pBestMvField, RefPicList
 
       if( bTM )
       {
-        uiCost = xFrucGetTempMatchCost( pu, nBlkWidth, nBlkHeight, eCurRefPicList, *pos, uiCost );
+        uiCost = xFrucGetTempMatchCost( pu, nBlkWidth, nBlkHeight, eCurRefPicList, *pos, uiCost, uiMinCost );
       }
       else
       {
@@ -2560,6 +2286,8 @@ Bool InterPrediction::deriveFRUCMV( PredictionUnit &pu )
 
   PU::getInterMergeCandidates( pu, mrgCtx );
 
+  xFrucResetCostCache();
+
   bAvailable = xFrucFindBlkMv( pu, mrgCtx );
   if( bAvailable )
   {
@@ -2731,7 +2459,7 @@ UInt InterPrediction::xFrucRefineMvSearch ( MvField* pBestMvField, RefPicList eC
       {
         if( PU::isSameMVField( pu, eCurRefPicList, mvCand, ( RefPicList )( !eCurRefPicList ), pBestMvField[!eCurRefPicList] ) )
           continue;
-        uiCost = xFrucGetTempMatchCost( pu, nBlkWidth, nBlkHeight, eCurRefPicList, mvCand, uiCost );
+        uiCost = xFrucGetTempMatchCost( pu, nBlkWidth, nBlkHeight, eCurRefPicList, mvCand, uiCost, uiMinDist );
       }
       else
       {
@@ -2773,6 +2501,8 @@ Bool InterPrediction::frucFindBlkMv4Pred( PredictionUnit& pu, RefPicList eTarget
 
   PU::getInterMergeCandidates( pu, mrgCtx );
 
+  xFrucResetCostCache();
+
   Bool bAvailable = false;
   if( pu.cs->slice->getSPS()->getSpsNext().getUseFRUCMrgMode() )
   {
@@ -2994,6 +2724,9 @@ Int InterPrediction::xFrucGetSubBlkSize( PredictionUnit& pu, Int nBlkWidth, Int
 
 Bool InterPrediction::xFrucGetCurBlkTemplate( PredictionUnit& pu, Int nCurBlkWidth, Int nCurBlkHeight )
 {
+  // the template matching costs refer to the current template
+  xFrucResetCostCache();
+
   m_bFrucTemplateAvailabe[0] = xFrucIsTopTempAvailable( pu );
   m_bFrucTemplateAvailabe[1] = xFrucIsLeftTempAvailable( pu );
 
@@ -3049,6 +2782,8 @@ Bool InterPrediction::xFrucIsLeftTempAvailable( PredictionUnit& pu )
 
 Void InterPrediction::xFrucUpdateTemplate( PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField )
 {
+  xFrucResetCostCache();
+
   const Int nMVUnit = 2;
 
   const MvField *pMvFieldOther = &rCurMvField;
@@ -3196,6 +2931,16 @@ UInt InterPrediction::xDirectMCCost( Int iBitDepth, Pel* pRef, UInt uiRefStride,
   return uiCost;
 }
 
+Void InterPrediction::xDirectMCCostWindow( Int iBitDepth, Pel* pRef, UInt uiRefStride, const Pel* pOrg, UInt uiOrgStride, Int iWidth, Int iHeight, Int iRange, Distortion* pCost )
+{
+  DistParam cDistParam;
+  cDistParam.applyWeight = false;
+  cDistParam.useMR = false;
+
+  m_pcRdCost->setDistParam( cDistParam, pOrg, pRef, uiOrgStride, uiRefStride, iBitDepth, COMPONENT_Y, iWidth, iHeight );
+  m_pcRdCost->getSADWindow( cDistParam, iRange, pCost );
+}
+
 Void InterPrediction::xBIPMVRefine( PredictionUnit& pu, RefPicList eRefPicList, Int iWidth, Int iHeight, const CPelUnitBuf &pcYuvOrg, UInt uiMaxSearchRounds, UInt nSearchStepShift, UInt& uiMinCost, Bool fullPel /*= true*/ )
 {
   const Mv mvSearchOffsetSquare[8] = { Mv(-1 , 1) , Mv(0 , 1) , Mv(1 , 1) , Mv(1 , 0) , Mv(1 , -1) , Mv(0 , -1) , Mv(-1 , -1) , Mv(-1 , 0) };
@@ -3213,6 +2958,19 @@ Void InterPrediction::xBIPMVRefine( PredictionUnit& pu, RefPicList eRefPicList,
 
   Int nBestDirect;
 
+  const Int iWinSize = 2 * DMVR_INTME_RANGE + 1;
+  Distortion searchCost[( 2 * DMVR_INTME_RANGE + 1 ) * ( 2 * DMVR_INTME_RANGE + 1 )];
+
+  if( fullPel )
+  {
+    // the padded prediction covers the whole search window, evaluate all integer positions at once
+    Int iRefStride = MAX_CU_SIZE + DMVR_INTME_RANGE*2;
+    Pel* pRef = m_cYuvPredTempDMVR[0] + DMVR_INTME_RANGE * iRefStride + DMVR_INTME_RANGE;
+    xDirectMCCostWindow( pu.cs->sps->getBitDepth(toChannelType(COMPONENT_Y)), pRef, iRefStride, (Pel*) pcYuvOrg.Y().buf, pcYuvOrg.bufs[0].stride, iWidth, iHeight, DMVR_INTME_RANGE, searchCost );
+
+    uiMinCost = std::min<UInt>( uiMinCost, ( UInt ) searchCost[DMVR_INTME_RANGE * iWinSize + DMVR_INTME_RANGE] );
+  }
+
   for (UInt uiRound = 0; uiRound < uiMaxSearchRounds; uiRound++)
   {
     nBestDirect = -1;
@@ -3244,10 +3002,7 @@ Void InterPrediction::xBIPMVRefine( PredictionUnit& pu, RefPicList eRefPicList,
 
         CHECK( cMvD.getAbsHor() > DMVR_INTME_RANGE || cMvD.getAbsVer() > DMVR_INTME_RANGE, "wrong");
 
-        Int iRefStride = MAX_CU_SIZE + DMVR_INTME_RANGE*2;
-
-        Pel* pRef = m_cYuvPredTempDMVR[0] + (DMVR_INTME_RANGE + cMvD.getVer()) * iRefStride + DMVR_INTME_RANGE + cMvD.getHor();
-        uiCost = xDirectMCCost( pu.cs->sps->getBitDepth(toChannelType(COMPONENT_Y)), pRef, iRefStride, (Pel*) pcYuvOrg.Y().buf, pcYuvOrg.bufs[0].stride, iWidth, iHeight );
+        uiCost = ( UInt ) searchCost[( DMVR_INTME_RANGE + cMvD.getVer() ) * iWinSize + DMVR_INTME_RANGE + cMvD.getHor()];
       }
       else
       {
@@ -3309,12 +3064,12 @@ Void InterPrediction::xProcessDMVR( PredictionUnit& pu, PelUnitBuf &pcYuvDst, co
   pcYuvDst.addAvg( srcPred0, srcPred1, clpRngs, false, true );
 
   //list 0
-  //get init cost
+  //get init cost from the centre of the search window
   srcPred0.Y().toLast( clpRngs.comp[COMPONENT_Y] );
-  UInt uiMinCost = xDirectMCCost( clpRngs.comp[COMPONENT_Y].bd, pcYuvDst.Y().buf, pcYuvDst.Y().stride, srcPred0.Y().buf, srcPred0.Y().stride, pu.lumaSize().width, pu.lumaSize().height );
-
   xFillPredBlckAndBorder( pu, REF_PIC_LIST_0, pu.lumaSize().width, pu.lumaSize().height, srcPred0.Y() );
 
+  UInt uiMinCost = MAX_UINT;
+
   xBIPMVRefine( pu, REF_PIC_LIST_0, pu.lumaSize().width, pu.lumaSize().height, pcYuvDst, DMVR_INTME_RANGE, searchStepShift, uiMinCost );
 
   Mv mv = pu.mv[0];
@@ -3331,12 +3086,12 @@ Void InterPrediction::xProcessDMVR( PredictionUnit& pu, PelUnitBuf &pcYuvDst, co
   }
 
   //list 1
-  //get init cost
+  //get init cost from the centre of the search window
   srcPred1.Y().toLast( clpRngs.comp[COMPONENT_Y] );
-  uiMinCost = xDirectMCCost( clpRngs.comp[COMPONENT_Y].bd, pcYuvDst.Y().buf, pcYuvDst.Y().stride, srcPred1.Y().buf, srcPred1.Y().stride, pu.lumaSize().width, pu.lumaSize().height );
-
   xFillPredBlckAndBorder( pu, REF_PIC_LIST_1, pu.lumaSize().width, pu.lumaSize().height, srcPred1.Y() );
 
+  uiMinCost = MAX_UINT;
+
   xBIPMVRefine( pu, REF_PIC_LIST_1, pu.lumaSize().width, pu.lumaSize().height, pcYuvDst, DMVR_INTME_RANGE, searchStepShift, uiMinCost );
 
   mv = pu.mv[1];
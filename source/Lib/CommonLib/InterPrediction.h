@@ -63,6 +63,54 @@ class Mv;
 
 #if JEM_TOOLS
 #define BIO_TEMP_BUFFER_SIZE ( MAX_CU_SIZE ) * ( MAX_CU_SIZE )
+#define FRUC_COST_CACHE_LOG2 8
+#define FRUC_COST_CACHE_SIZE ( 1 << FRUC_COST_CACHE_LOG2 )
+
+// FRUC start MV candidates in insertion order, the hash mask allows to reject most duplicate checks without a search
+struct FrucMvList
+{
+  std::vector<MvField> mvField;
+  UInt64               hashMask;
+
+  FrucMvList() : hashMask( 0 ) { mvField.reserve( 64 ); }
+
+  Void clear() { mvField.clear(); hashMask = 0; }
+};
+
+// matching cost of one FRUC candidate, valid as long as the generation matches
+struct FrucMatchCost
+{
+  UInt     generation;
+  Position pos;
+  Int      width;
+  Int      height;
+  Int      refList;
+  Int      refIdx;
+  Int      hor;
+  Int      ver;
+  Bool     highPrec;
+  Bool     bTM;
+  UInt     dist;
+  MvField  pairMvField;
+};
+
+#define LIC_PARAM_CACHE_LOG2 6
+#define LIC_PARAM_CACHE_SIZE ( 1 << LIC_PARAM_CACHE_LOG2 )
+
+// LIC model of one block and reference, valid as long as the generation matches
+struct LICParamCache
+{
+  UInt           generation;
+  CompArea       area;
+  const Picture* refPic;
+  Int            horIntMv;
+  Int            verIntMv;
+  Bool           above;
+  Bool           left;
+  Int            shift;
+  Int            scale;
+  Int            offset;
+};
 #endif
 
 class InterPrediction : public WeightPrediction
@@ -73,6 +121,8 @@ private:
   static const int  m_LICRegShift   = 7;
   static const int  m_LICShiftDiff  = 12;
   int               m_LICMultApprox[64];
+  LICParamCache     m_LICParamCache[LIC_PARAM_CACHE_SIZE];
+  UInt              m_LICParamCacheGen;
 #endif
 
 #if JEM_TOOLS
@@ -81,6 +131,7 @@ private:
   Int64 m_piDotProduct3[BIO_TEMP_BUFFER_SIZE];
   Int64 m_piDotProduct5[BIO_TEMP_BUFFER_SIZE];
   Int64 m_piDotProduct6[BIO_TEMP_BUFFER_SIZE];
+  Int64 m_piBlkGradSums[BIO_NUM_GRAD_SUMS * ( BIO_TEMP_BUFFER_SIZE >> 4 )];
 #endif
 
 protected:
@@ -115,21 +166,10 @@ protected:
 #endif
 
   // motion compensation functions
-#define BIO_FILTER_LENGTH                 6
-#define BIO_FILTER_LENGTH_MINUS_1         (BIO_FILTER_LENGTH-1)
-#define BIO_FILTER_HALF_LENGTH_MINUS_1    ((BIO_FILTER_LENGTH>>1)-1)
-
   Void          xGradFilterX    ( const Pel* piRefY, Int iRefStride, Pel*  piDstY, Int iDstStride, Int iWidth, Int iHeight, Int iMVyFrac, Int iMVxFrac, const Int bitDepth );
   Void          xGradFilterY    ( const Pel* piRefY, Int iRefStride, Pel*  piDstY, Int iDstStride, Int iWidth, Int iHeight, Int iMVyFrac, Int iMVxFrac, const Int bitDepth );
-  inline Void   gradFilter2DVer ( const Pel* piSrc, Int iSrcStride, Int iWidth, Int iHeight, Int iDstStride, Pel*& rpiDst, Int iMv, const Int iShift );
-  inline Void   gradFilter2DHor ( const Pel* piSrc, Int iSrcStride, Int iWidth, Int iHeight, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift );
-  inline Void   fracFilter2DHor ( const Pel* piSrc, Int iSrcStride, Int iWidth, Int iHeight, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift );
-  inline Void   fracFilter2DVer ( const Pel* piSrc, Int iSrcStride, Int iWidth, Int iHeight, Int iDstStride, Pel*& rpiDst, Int iMv, const Int iShift );
-  inline Void   gradFilter1DHor ( const Pel* piSrc, Int iSrcStride, Int iWidth, Int iHeight, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift );
-  inline Void   gradFilter1DVer ( const Pel* piSrc, Int iSrcStride, Int iWidth, Int iHeight, Int iDstStride, Pel*& rpiDst, Int iMV, const Int iShift );
 
   inline Int64  divide64        ( Int64 numer, Int64 denom);
-  inline Void   calcBlkGradient ( Int sx, Int sy, Int64 *arraysGx2, Int64 *arraysGxGy, Int64 *arraysGxdI, Int64 *arraysGy2, Int64 *arraysGydI, Int64 &sGx2, Int64 &sGy2, Int64 &sGxGy, Int64 &sGxdI, Int64 &sGydI, Int iWidth, Int iHeight);
 
   Pel  optical_flow_averaging   ( Int64 s1, Int64 s2, Int64 s3, Int64 s5, Int64 s6,
                                   Pel pGradX0, Pel pGradX1, Pel pGradY0, Pel pGradY1, Pel pSrcY0Temp, Pel pSrcY1Temp,
@@ -165,6 +205,7 @@ protected:
   Void xSubPuMC                 ( PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList = REF_PIC_LIST_X );
   Void xSubblockOBMC            ( const ComponentID eComp, PredictionUnit &pu, PelUnitBuf &pcYuvPredDst, PelUnitBuf &pcYuvPredSrc, Int iDir, Bool bOBMCSimp );
   Void xSubtractOBMC            ( PredictionUnit &pu, PelUnitBuf &pcYuvPredDst, PelUnitBuf &pcYuvPredSrc, Int iDir, Bool bOBMCSimp );
+  Void xSubBlockOBMCArea        ( PredictionUnit &pu, const MotionInfo &neighMi, const Area &blkArea, PelUnitBuf &pcYuvPred, PelUnitBuf &pcYuvTmpPred, Int iDir, Bool bOBMCSimp, Bool bOBMC4ME );
 #endif
 #if JEM_TOOLS
   Void xSubBlockMotionCompensation( PredictionUnit &pu, PelUnitBuf &pcYuvPred );
@@ -176,8 +217,10 @@ protected:
   MotionInfo      m_SubPuMiBuf   [( MAX_CU_SIZE * MAX_CU_SIZE ) >> ( MIN_CU_LOG2 << 1 )];
   MotionInfo      m_SubPuExtMiBuf[( MAX_CU_SIZE * MAX_CU_SIZE ) >> ( MIN_CU_LOG2 << 1 )];
 
-  std::list<MvField> m_listMVFieldCand[2];
+  FrucMvList m_listMVFieldCand[2];
   RefPicList m_bilatBestRefPicList;
+  FrucMatchCost m_frucCostCache[FRUC_COST_CACHE_SIZE];
+  UInt   m_frucCostCacheGen;
   Pel*   m_acYuvPredFrucTemplate[2][MAX_NUM_COMPONENT];   //0: top, 1: left
   Bool   m_bFrucTemplateAvailabe[2];
 
@@ -193,12 +236,15 @@ protected:
 
   UInt xFrucGetMvCost           (const Mv& rMvStart, const Mv& rMvCur, Int nSearchRange, Int nWeighting, UInt precShift );
   UInt xFrucGetBilaMatchCost    (PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField, MvField& rPairMVField, UInt uiMVCost );
-  UInt xFrucGetTempMatchCost    (PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField, UInt uiMVCost );
+  UInt xFrucGetTempMatchCost    (PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField, UInt uiMVCost, UInt uiMaxCost = MAX_UINT );
   Void xFrucUpdateTemplate      (PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField );
 
+  Void xFrucResetCostCache      ();
+  FrucMatchCost&
+       xFrucGetCostCacheEntry   (const PredictionUnit& pu, Int nWidth, Int nHeight, RefPicList eCurRefPicList, const MvField& rCurMvField, Bool bTM, Bool& rbHit);
 
-  Void xFrucInsertMv2StartList  (const MvField & rMvField, std::list<MvField> & rList,Bool setHighPrec);
-  Bool xFrucIsInList            (const MvField & rMvField, std::list<MvField> & rList);
+  Void xFrucInsertMv2StartList  (const MvField & rMvField, FrucMvList & rList,Bool setHighPrec);
+  Bool xFrucIsInList            (const MvField & rMvField, const FrucMvList & rList);
 
   Bool xFrucGetCurBlkTemplate   (PredictionUnit& pu, Int nCurBlkWidth , Int nCurBlkHeight);
   Bool xFrucIsTopTempAvailable  (PredictionUnit& pu);
@@ -207,6 +253,7 @@ protected:
 
   Void xBIPMVRefine             (PredictionUnit& pu, RefPicList eRefPicList, Int iWidth, Int iHeight, const CPelUnitBuf &pcYuvOrg, UInt uiMaxSearchRounds, UInt nSearchStepShift, UInt& uiMinCost, Bool fullPel = true);
   UInt xDirectMCCost            (Int iBitDepth, Pel* pRef, UInt uiRefStride, const Pel* pOrg, UInt uiOrgStride, Int iWidth, Int iHeight);
+  Void xDirectMCCostWindow      (Int iBitDepth, Pel* pRef, UInt uiRefStride, const Pel* pOrg, UInt uiOrgStride, Int iWidth, Int iHeight, Int iRange, Distortion* pCost);
   Void xPredInterLines          (const PredictionUnit& pu, const Picture* refPic, Mv &mv, PelUnitBuf &dstPic, const Bool &bi, const ClpRng& clpRng );
   Void xFillPredBlckAndBorder   (const PredictionUnit& pu, RefPicList eRefPicList, Int iWidth, Int iHeight, PelBuf &cTmpY );
   Void xProcessDMVR             (      PredictionUnit& pu, PelUnitBuf &pcYuvDst, const ClpRngs &clpRngs, const bool bBIOApplied);
@@ -229,6 +276,10 @@ public:
 
   Bool    deriveFRUCMV        (PredictionUnit &pu);
   Bool    frucFindBlkMv4Pred  (PredictionUnit& pu, RefPicList eTargetRefPicList, const Int nTargetRefIdx, AMVPInfo* pInfo = NULL);
+
+  // enables the LIC parameter cache and invalidates its entries, to be called whenever the reconstruction of the
+  // neighbourhood of the blocks to be predicted may have changed (the cache stays disabled if this is never called)
+  Void    resetLICParamCache  ();
 #endif
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   void    cacheAssign( CacheModel *cache );
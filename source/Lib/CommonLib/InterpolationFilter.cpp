@@ -199,6 +199,14 @@ InterpolationFilter::InterpolationFilter()
   m_filterCopy[1][0]   = filterCopy<true, false>;
   m_filterCopy[1][1]   = filterCopy<true, true>;
 
+#if JEM_TOOLS
+  m_filter4x4[0]       = filter4x4<false>;
+  m_filter4x4[1]       = filter4x4<true>;
+  m_filterBio[0]       = filterBio<false>;
+  m_filterBio[1]       = filterBio<true>;
+  m_bioGradSums        = bioGradSums;
+  m_bioApply           = bioApply;
+#endif
 }
 
 
@@ -471,6 +479,187 @@ Void InterpolationFilter::filterVer(const ClpRng& clpRng, Pel const *src, Int sr
   }
 }
 
+#if JEM_TOOLS
+/**
+ * \brief Filter a 4x4 luma block in both directions
+ *
+ * Equivalent to a horizontal pass over the 4 + NTAPS_LUMA - 1 rows covered by the
+ * vertical filter followed by the vertical pass over the intermediate samples.
+ *
+ * \tparam isLast     Flag indicating whether it is the last filtering operation
+ * \param  coeffH     Pointer to the horizontal filter taps
+ * \param  coeffV     Pointer to the vertical filter taps
+ */
+template<Bool isLast>
+Void InterpolationFilter::filter4x4( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV )
+{
+  const Int vFilterSize = NTAPS_LUMA;
+  Pel       tmp[( 4 + vFilterSize - 1 ) * 4];
+
+  filter<NTAPS_LUMA, false, true, false>( clpRng, src - ( ( vFilterSize >> 1 ) - 1 ) * srcStride, srcStride, tmp, 4, 4, 4 + vFilterSize - 1, coeffH );
+  JVET_J0090_SET_CACHE_ENABLE( false );
+  filter<NTAPS_LUMA, true, false, isLast>( clpRng, tmp + ( ( vFilterSize >> 1 ) - 1 ) * 4, 4, dst, dstStride, 4, 4, coeffV );
+  JVET_J0090_SET_CACHE_ENABLE( true );
+}
+
+/**
+ * \brief Apply a 6-tap BIO gradient or fractional filter to a block of samples
+ *
+ * The sum is rounded symmetrically around zero, i.e. the rounding offset is applied to its magnitude.
+ *
+ * \tparam isVertical Flag indicating whether it is vertical filtering
+ * \param  src        Pointer to source samples (filter center)
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  coeff      Pointer to filter taps
+ * \param  shift      Right shift of the filtered sum
+ * \param  offset     Rounding offset added to the magnitude of the filtered sum
+ */
+template<Bool isVertical>
+Void InterpolationFilter::filterBio( Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Short const *coeff, Int shift, Int offset )
+{
+  const Int cStride = isVertical ? srcStride : 1;
+  src -= BIO_FILTER_HALF_LENGTH_MINUS_1 * cStride;
+
+  for( Int row = 0; row < height; row++ )
+  {
+    for( Int col = 0; col < width; col++ )
+    {
+      Int sum = 0;
+
+      for( Int i = 0; i < BIO_FILTER_LENGTH; i++ )
+      {
+        JVET_J0090_CACHE_ACCESS( &src[col + i * cStride], __FILE__, __LINE__ );
+        sum += coeff[i] * src[col + i * cStride];
+      }
+
+      sum      = ( sum >= 0 ? ( sum + offset ) >> shift : -( ( -sum + offset ) >> shift ) );
+      dst[col] = ( Pel ) sum;
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+/**
+ * \brief Calculate the BIO gradient correlation sums of all 4x4 sub-blocks
+ *
+ * The sums are taken over the 8x8 window around each sub-block, weighted with a (1,2,3,4,4,3,2,1) tent in both directions
+ * and with the window clamped to the block. They are stored as BIO_NUM_GRAD_SUMS consecutive entries per sub-block
+ * in raster order: sGx2, sGxGy, sGxdI, sGy2 and sGydI.
+ *
+ * \param  dotProducts  Temporary per-sample product planes of width x height entries each
+ * \param  blkSums      Output sums, BIO_NUM_GRAD_SUMS entries per 4x4 sub-block
+ */
+Void InterpolationFilter::bioGradSums( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, Int width, Int height, Int64* const dotProducts[BIO_NUM_GRAD_SUMS], Int64* blkSums )
+{
+  static const UInt weightTbl[8][8] = { {1, 2, 3, 4, 4, 3, 2, 1},
+      {2, 4, 6, 8, 8, 6, 4, 2},
+      {3, 6, 9, 12, 12, 9, 6, 3},
+      {4, 8, 12, 16, 16, 12, 8, 4},
+      {4, 8, 12, 16, 16, 12, 8, 4},
+      {3, 6, 9, 12, 12, 9, 6, 3},
+      {2, 4, 6, 8, 8, 6, 4, 2},
+      {1, 2, 3, 4, 4, 3, 2, 1 } };
+
+  Int64* pGx2  = dotProducts[0];
+  Int64* pGxGy = dotProducts[1];
+  Int64* pGxdI = dotProducts[2];
+  Int64* pGy2  = dotProducts[3];
+  Int64* pGydI = dotProducts[4];
+
+  Int64 temp = 0, tempX = 0, tempY = 0;
+  for( Int y = 0; y < height; y++ )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      temp  = (Int64)( src0  [x] - src1  [x] );
+      tempX = (Int64)( gradX0[x] + gradX1[x] );
+      tempY = (Int64)( gradY0[x] + gradY1[x] );
+      pGx2 [x] =  tempX * tempX;
+      pGxGy[x] =  tempX * tempY;
+      pGxdI[x] = -tempX * temp<<5;
+      pGy2 [x] =  tempY * tempY<<1;
+      pGydI[x] = -tempY * temp<<6;
+    }
+    src0   += src0Stride;
+    src1   += src1Stride;
+    gradX0 += width;
+    gradX1 += width;
+    gradY0 += width;
+    gradY1 += width;
+    pGx2   += width;
+    pGxGy  += width;
+    pGxdI  += width;
+    pGy2   += width;
+    pGydI  += width;
+  }
+
+  for( Int sy = 0; sy < height; sy += 4 )
+  {
+    for( Int sx = 0; sx < width; sx += 4, blkSums += BIO_NUM_GRAD_SUMS )
+    {
+      for( Int k = 0; k < BIO_NUM_GRAD_SUMS; k++ )
+      {
+        blkSums[k] = 0;
+      }
+
+      for( Int y = -2; y < 6; y++ )
+      {
+        const Int y0 = std::min( std::max( sy + y, 0 ), height - 1 );
+
+        for( Int x = -2; x < 6; x++ )
+        {
+          const UInt weight = weightTbl[y + 2][x + 2];
+          const Int  x0     = std::min( std::max( sx + x, 0 ), width - 1 );
+
+          for( Int k = 0; k < BIO_NUM_GRAD_SUMS; k++ )
+          {
+            blkSums[k] += weight * dotProducts[k][y0 * width + x0];
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * \brief Apply the BIO refinement of the bi-prediction samples
+ *
+ * \param  vx, vy     Motion refinement of each 4x4 sub-block in raster order
+ * \param  shiftNum   Right shift of the bi-prediction average
+ * \param  offset     Rounding offset of the bi-prediction average
+ */
+Void InterpolationFilter::bioApply( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, Pel* dst, Int dstStride, Int width, Int height, const Int* vx, const Int* vy, Int shiftNum, Int offset, const ClpRng& clpRng )
+{
+  for( Int y = 0; y < height; y++ )
+  {
+    const Int* blkVx = vx + ( y >> 2 ) * ( width >> 2 );
+    const Int* blkVy = vy + ( y >> 2 ) * ( width >> 2 );
+
+    for( Int x = 0; x < width; x++ )
+    {
+      Int b = blkVx[x >> 2] * ( gradX0[x] - gradX1[x] ) + blkVy[x >> 2] * ( gradY0[x] - gradY1[x] );
+      b = ( b > 0 ) ? ( ( b + 32 ) >> 6 ) : ( -( ( -b + 32 ) >> 6 ) );
+
+      dst[x] = ( ClipPel( ( Short ) ( ( src0[x] + src1[x] + b + offset ) >> shiftNum ), clpRng ) );
+    }
+
+    src0   += src0Stride;
+    src1   += src1Stride;
+    gradX0 += width;
+    gradX1 += width;
+    gradY0 += width;
+    gradY1 += width;
+    dst    += dstStride;
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -587,6 +776,28 @@ Void InterpolationFilter::filterVer( const ComponentID compID, Pel const *src, I
   }
 }
 
+#if JEM_TOOLS
+/**
+ * \brief Filter a 4x4 block of Luma samples in both directions (affine sub-block)
+ *
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  fracX      Horizontal fractional sample offset, must not be zero
+ * \param  fracY      Vertical fractional sample offset, must not be zero
+ * \param  isLast     Flag indicating whether it is the last filtering operation
+ * \param  clpRng     Clipping range
+ */
+Void InterpolationFilter::filterLuma4x4( Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int fracX, Int fracY, Bool isLast, const ClpRng& clpRng )
+{
+  CHECK( fracX <= 0 || fracX >= ( LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE ), "Invalid fraction" );
+  CHECK( fracY <= 0 || fracY >= ( LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS << VCEG_AZ07_MV_ADD_PRECISION_BIT_FOR_STORE ), "Invalid fraction" );
+
+  m_filter4x4[isLast]( clpRng, src, srcStride, dst, dstStride, m_lumaFilter[fracX], m_lumaFilter[fracY] );
+}
+
+#endif
 /**
  * \brief turn on SIMD fuc
  *
@@ -49,6 +49,13 @@
 #define IF_FILTER_PREC    6 ///< Log2 of sum of filter taps
 #define IF_INTERNAL_OFFS (1<<(IF_INTERNAL_PREC-1)) ///< Offset used internally
 
+#if JEM_TOOLS
+#define BIO_FILTER_LENGTH                 6
+#define BIO_FILTER_LENGTH_MINUS_1         (BIO_FILTER_LENGTH-1)
+#define BIO_FILTER_HALF_LENGTH_MINUS_1    ((BIO_FILTER_LENGTH>>1)-1)
+#define BIO_NUM_GRAD_SUMS                 5                       ///< sGx2, sGxGy, sGxdI, sGy2 and sGydI of a 4x4 sub-block
+#endif
+
 /**
  * \brief Interpolation filter class
  */
@@ -69,6 +76,15 @@ public:
   template<Int N, Bool isVertical, Bool isFirst, Bool isLast>
   static Void filter(const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff);
 
+#if JEM_TOOLS
+  template<Bool isLast>
+  static Void filter4x4( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV );
+  template<Bool isVertical>
+  static Void filterBio( Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Short const *coeff, Int shift, Int offset );
+  static Void bioGradSums( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, Int width, Int height, Int64* const dotProducts[BIO_NUM_GRAD_SUMS], Int64* blkSums );
+  static Void bioApply( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, Pel* dst, Int dstStride, Int width, Int height, const Int* vx, const Int* vy, Int shiftNum, Int offset, const ClpRng& clpRng );
+#endif
+
   template<Int N>
   Void filterHor(const ClpRng& clpRng, Pel const* src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height,               Bool isLast, TFilterCoeff const *coeff);
   template<Int N>
@@ -85,6 +101,14 @@ public:
   Void( *m_filterHor[3][2][2] )( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff );
   Void( *m_filterVer[3][2][2] )( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff );
   Void( *m_filterCopy[2][2] )  ( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height );
+#if JEM_TOOLS
+  // affine: separable 8-tap luma interpolation of a single 4x4 sub-block [isLast]
+  Void( *m_filter4x4[2] )      ( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV );
+  // BIO: 6-tap gradient/fractional filters [isVertical], windowed gradient correlation sums and the sample refinement
+  Void( *m_filterBio[2] )      ( Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Short const *coeff, Int shift, Int offset );
+  Void( *m_bioGradSums )       ( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, Int width, Int height, Int64* const dotProducts[BIO_NUM_GRAD_SUMS], Int64* blkSums );
+  Void( *m_bioApply )          ( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, Pel* dst, Int dstStride, Int width, Int height, const Int* vx, const Int* vy, Int shiftNum, Int offset, const ClpRng& clpRng );
+#endif
 
   void initInterpolationFilter( bool enable );
 #ifdef TARGET_SIMD_X86
@@ -96,6 +120,7 @@ public:
 #if JEM_TOOLS
   Void filterHor(const ComponentID compID, Pel const* src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int frac,               Bool isLast, const ChromaFormat fmt, const ClpRng& clpRng, Int nFilterIdx = 0 );
   Void filterVer(const ComponentID compID, Pel const* src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int frac, Bool isFirst, Bool isLast, const ChromaFormat fmt, const ClpRng& clpRng, Int nFilterIdx = 0 );
+  Void filterLuma4x4( Pel const* src, Int srcStride, Pel *dst, Int dstStride, Int fracX, Int fracY, Bool isLast, const ClpRng& clpRng );
 #else
   Void filterHor(const ComponentID compID, Pel const* src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int frac,               Bool isLast, const ChromaFormat fmt, const ClpRng& clpRng );
   Void filterVer(const ComponentID compID, Pel const* src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int frac, Bool isFirst, Bool isLast, const ChromaFormat fmt, const ClpRng& clpRng );
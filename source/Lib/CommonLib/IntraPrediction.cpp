@@ -85,6 +85,81 @@ const UChar IntraPrediction::m_aucIntraFilter[MAX_NUM_CHANNEL_TYPE][MAX_INTRA_FI
   }
 };
 
+#if JEM_TOOLS
+// ====================================================================================================================
+// Cross-component linear model kernels
+// ====================================================================================================================
+
+//  If you change the functionality here, consider to switch off the SIMD implementation of these functions.
+
+static Void lumaDownsampleCore( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, Bool leftAvailable )
+{
+  for( Int j = 0; j < height; j++ )
+  {
+    for( Int i = 0; i < width; i++ )
+    {
+      if( i == 0 && !leftAvailable )
+      {
+        dst[i] = ( src[2 * i] + src[2 * i + srcStride] + 1 ) >> 1;
+      }
+      else
+      {
+        dst[i] = ( src[2 * i            ] * 2 + src[2 * i + 1            ] + src[2 * i - 1            ]
+                 + src[2 * i + srcStride] * 2 + src[2 * i + 1 + srcStride] + src[2 * i - 1 + srcStride]
+                 + 4 ) >> 3;
+      }
+    }
+
+    src += srcStride << 1;
+    dst += dstStride;
+  }
+}
+
+static Void lumaFilterGroupCore( const Pel* src, Int srcStride, Pel* const dst[LM_FILTER_NUM], Int dstStride, Int width, Int height )
+{
+  for( Int j = 0; j < height; j++ )
+  {
+    const Pel* piSrc = src + ( j * srcStride << 1 );
+    const Int  iOffs = j * dstStride;
+
+    for( Int i = 0; i < width; i++, piSrc += 2 )
+    {
+      dst[0][iOffs + i] = ( piSrc[1] + piSrc[srcStride + 1] + 1 ) >> 1;
+      dst[1][iOffs + i] = ( piSrc[srcStride] + piSrc[srcStride + 1] + 1 ) >> 1;
+      dst[3][iOffs + i] = ( piSrc[0] + piSrc[1] + 1 ) >> 1;
+      dst[2][iOffs + i] = ( piSrc[0] + piSrc[1] + piSrc[srcStride] + piSrc[srcStride + 1] + 2 ) >> 2;
+    }
+  }
+}
+
+static Void lmAccumulateCore( const Pel* src, const Pel* cur, Int num, Int& x, Int& y, Int& xx, Int& xy )
+{
+  for( Int i = 0; i < num; i++ )
+  {
+    x  += src[i];
+    y  += cur[i];
+    xx += src[i] * src[i];
+    xy += src[i] * cur[i];
+  }
+}
+
+static Void lmPredTwoModelCore( const Pel* luma, Int lumaStride, Pel* dst, Int dstStride, Int width, Int height, Int threshold, const Int a[2], const Int b[2], const Int shift[2], const ClpRng& clpRng )
+{
+  for( Int j = 0; j < height; j++ )
+  {
+    for( Int i = 0; i < width; i++ )
+    {
+      const Int k = luma[i] <= threshold ? 0 : 1;
+
+      dst[i] = ( Pel ) ClipPel( ( ( a[k] * luma[i] ) >> shift[k] ) + b[k], clpRng );
+    }
+
+    luma += lumaStride;
+    dst  += dstStride;
+  }
+}
+
+#endif
 // ====================================================================================================================
 // Constructor / destructor / initialize
 // ====================================================================================================================
@@ -108,6 +183,15 @@ IntraPrediction::IntraPrediction()
   {
     m_pLumaRecBufferMul[i] = nullptr;
   }
+
+  m_lumaDownsample  = lumaDownsampleCore;
+  m_lumaFilterGroup = lumaFilterGroupCore;
+  m_lmAccumulate    = lmAccumulateCore;
+  m_lmPredTwoModel  = lmPredTwoModelCore;
+
+#if ENABLE_SIMD_OPT_CCLM && defined( TARGET_SIMD_X86 )
+  initIntraPredictionX86();
+#endif
 #endif
 }
 
@@ -393,36 +477,11 @@ Void IntraPrediction::predIntraChromaLM(const ComponentID compID, PelBuf &piPred
     PelBuf Temp = PelBuf(m_piTemp + (iLumaStride + 1) *MMLM_Lines, iLumaStride, Size(chromaArea));//MMLM_SAMPLE_NEIGHBOR_LINES;
     Pel  *pLuma = Temp.bufAt(0, 0);
 
-    Pel*  pPred = piPred.bufAt(0, 0);
-    Int  uiPredStride = piPred.stride;
-
-    UInt uiCWidth = chromaArea.width;
-    UInt uiCHeight = chromaArea.height;
-
-    for (Int i = 0; i < uiCHeight; i++)
-    {
-      for (Int j = 0; j < uiCWidth; j++)
-      {
-        Int a, b, iShift;
-        if (pLuma[j] <= parameters[0].Sup)
-        {
-          a = parameters[0].a;
-          b = parameters[0].b;
-          iShift = parameters[0].shift;
-        }
-        else
-        {
-          a = parameters[1].a;
-          b = parameters[1].b;
-          iShift = parameters[1].shift;
-        }
-
-        pPred[j] = ( Pel ) ClipPel( ( ( a * pLuma[j] ) >> iShift ) + b, pu.cs->slice->clpRng( compID ) );
-      }
+    const Int a     [2] = { parameters[0].a,     parameters[1].a     };
+    const Int b     [2] = { parameters[0].b,     parameters[1].b     };
+    const Int iShift[2] = { parameters[0].shift, parameters[1].shift };
 
-      pPred += uiPredStride;
-      pLuma += iLumaStride;
-    }
+    m_lmPredTwoModel( pLuma, iLumaStride, piPred.buf, piPred.stride, chromaArea.width, chromaArea.height, parameters[0].Sup, a, b, iShift, pu.cs->slice->clpRng( compID ) );
 
     if (pu.cs->sps->getSpsNext().isELMModeMFLM())
     {
@@ -1532,19 +1591,7 @@ Void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     pDst  = pDst0    - iDstStride;
     piSrc = pRecSrc0 - iRecStride2;
 
-    for( Int i = 0; i < uiCWidth; i++ )
-    {
-      if( i == 0 && !bLeftAvaillable )
-      {
-        pDst[i] = ( piSrc[2 * i] + piSrc[2 * i + iRecStride] + 1 ) >> 1;
-      }
-      else
-      {
-        pDst[i] = ( ( ( piSrc[2 * i             ] * 2 ) + piSrc[2 * i - 1             ] + piSrc[2 * i + 1             ] )
-                  + ( ( piSrc[2 * i + iRecStride] * 2 ) + piSrc[2 * i - 1 + iRecStride] + piSrc[2 * i + 1 + iRecStride] )
-                  + 4 ) >> 3;
-      }
-    }
+    m_lumaDownsample( piSrc, iRecStride, pDst, iDstStride, uiCWidth, 1, bLeftAvaillable );
 
     if (pu.cs->sps->getSpsNext().isELMModeMMLM())
     {
@@ -1553,19 +1600,7 @@ Void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
         pDst  = pDst0    - iDstStride  * line;
         piSrc = pRecSrc0 - iRecStride2 * line;
 
-        for (Int i = 0; i < uiCWidth; i++)
-        {
-          if (i == 0 && !bLeftAvaillable)
-          {
-            pDst[i] = (piSrc[2 * i] + piSrc[2 * i + iRecStride] + 1) >> 1;
-          }
-          else
-          {
-            pDst[i] = ( ( (piSrc[2 * i             ] * 2 ) + piSrc[2 * i - 1             ] + piSrc[2 * i + 1             ] )
-                      + ( (piSrc[2 * i + iRecStride] * 2 ) + piSrc[2 * i - 1 + iRecStride] + piSrc[2 * i + 1 + iRecStride] )
-                      + 4 ) >> 3;
-          }
-        }
+        m_lumaDownsample( piSrc, iRecStride, pDst, iDstStride, uiCWidth, 1, bLeftAvaillable );
       }
     }
 
@@ -1578,11 +1613,7 @@ Void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 
       piSrc = pRecSrc0 - iRecStride2;
 
-      for (Int i = 0; i < uiCWidth; i++)
-      {
-
-        xFilterGroup(pMulDst, i, &piSrc[2 * i], iRecStride, bAboveAvaillable, i != 0 || bLeftAvaillable);
-      }
+      m_lumaFilterGroup( piSrc, iRecStride, pMulDst, iDstStride, uiCWidth, 1 );
 
       if (pu.cs->sps->getSpsNext().isELMModeMMLM())
       {
@@ -1596,10 +1627,7 @@ Void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 
           piSrc = pRecSrc0 - iRecStride2 * line;
 
-          for (Int i = 0; i < uiCWidth; i++)
-          {
-            xFilterGroup(pMulDst, i, &piSrc[2 * i], iRecStride, bAboveAvaillable, i != 0 || bLeftAvaillable);
-          }
+          m_lumaFilterGroup( piSrc, iRecStride, pMulDst, iDstStride, uiCWidth, 1 );
         }
       }
     }
@@ -1689,43 +1717,11 @@ Void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 
 
   // inner part from reconstructed picture buffer
-  for( Int j = 0; j < uiCHeight; j++ )
-  {
-    for( Int i = 0; i < uiCWidth; i++ )
-    {
-      if( i == 0 && !bLeftAvaillable )
-      {
-        pDst0[i] = ( pRecSrc0[2 * i] + pRecSrc0[2 * i + iRecStride] + 1 ) >> 1;
-      }
-      else
-      {
-        pDst0[i] = ( pRecSrc0[2 * i             ] * 2 + pRecSrc0[2 * i + 1             ] + pRecSrc0[2 * i - 1             ]
-                   + pRecSrc0[2 * i + iRecStride] * 2 + pRecSrc0[2 * i + 1 + iRecStride] + pRecSrc0[2 * i - 1 + iRecStride]
-                   + 4 ) >> 3;
-      }
-    }
-
-    pDst0    += iDstStride;
-    pRecSrc0 += iRecStride2;
-  }
+  m_lumaDownsample( pRecSrc0, iRecStride, pDst0, iDstStride, uiCWidth, uiCHeight, bLeftAvaillable );
 
   if (pu.cs->sps->getSpsNext().isELMModeMFLM())
   {
-    pRecSrc0 = Src.bufAt(0, 0);
-
-    for (Int j = 0; j < uiCHeight; j++)
-    {
-      for (Int i = 0; i < uiCWidth; i++)
-      {
-        xFilterGroup(pMulDst0, i, &pRecSrc0[2 * i], iRecStride, j != 0 || bAboveAvaillable, i != 0 || bLeftAvaillable);
-      }
-      for (Int i = 0; i < LM_FILTER_NUM; i++)
-      {
-        pMulDst0[i] += iDstStride;
-      }
-
-      pRecSrc0 += iRecStride2;
-    }
+    m_lumaFilterGroup( pRecSrc0, iRecStride, pMulDst0, iDstStride, uiCWidth, uiCHeight );
   }
 }
 
@@ -2244,14 +2240,21 @@ Void IntraPrediction::xGetLMParameters(const PredictionUnit &pu, const Component
 
   if( bAboveAvaillable )
   {
-    for( int j = 0; j < numSteps; j++ )
+    if( minDim == uiCWidth )
+    {
+      m_lmAccumulate( pSrc, pCur, numSteps, x, y, xx, xy );
+    }
+    else
     {
-      int idx = ( j * minStep * uiCWidth ) / minDim;
+      for( int j = 0; j < numSteps; j++ )
+      {
+        int idx = ( j * minStep * uiCWidth ) / minDim;
 
-      x  += pSrc[idx];
-      y  += pCur[idx];
-      xx += pSrc[idx] * pSrc[idx];
-      xy += pSrc[idx] * pCur[idx];
+        x  += pSrc[idx];
+        y  += pCur[idx];
+        xx += pSrc[idx] * pSrc[idx];
+        xy += pSrc[idx] * pCur[idx];
+      }
     }
 
     iCountShift = g_aucLog2[minDim / minStep];
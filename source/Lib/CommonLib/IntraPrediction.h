@@ -141,6 +141,19 @@ public:
   virtual ~IntraPrediction();
 
   Void init                       (ChromaFormat chromaFormatIDC, const unsigned bitDepthY);
+#if JEM_TOOLS
+
+  Void( *m_lumaDownsample )  ( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, Bool leftAvailable );
+  Void( *m_lumaFilterGroup ) ( const Pel* src, Int srcStride, Pel* const dst[LM_FILTER_NUM], Int dstStride, Int width, Int height );
+  Void( *m_lmAccumulate )    ( const Pel* src, const Pel* cur, Int num, Int& x, Int& y, Int& xx, Int& xy );
+  Void( *m_lmPredTwoModel )  ( const Pel* luma, Int lumaStride, Pel* dst, Int dstStride, Int width, Int height, Int threshold, const Int a[2], const Int b[2], const Int shift[2], const ClpRng& clpRng );
+
+#if ENABLE_SIMD_OPT_CCLM && defined( TARGET_SIMD_X86 )
+  Void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  Void _initIntraPredictionX86();
+#endif
+#endif
 
   // Angular Intra
   void predIntraAng               ( const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu, const bool useFilteredPredSamples );
@@ -158,60 +158,32 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
   }
 #endif
 
+  // Vertical edges only modify samples within their line, so the CTU rows can be processed independently.
+  // Each thread works on its own copy of the filter, as the boundary strengths are kept per CTU.
+#pragma omp parallel for schedule(dynamic,1) if( pcv.heightInCtus > 1 )
   for( int y = 0; y < pcv.heightInCtus; y++ )
   {
+    LoopFilter loopFilter( *this );
+
     for( int x = 0; x < pcv.widthInCtus; x++ )
     {
-      memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-
       const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
 
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_VER );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_VER );
-        }
-      }
+      loopFilter.xDeblockCtu( cs, ctuArea, EDGE_VER );
     }
   }
 
-  // Vertical filtering
-  for( int y = 0; y < pcv.heightInCtus; y++ )
+  // Horizontal filtering, the horizontal edges only modify samples within their column, so the CTU columns are independent
+#pragma omp parallel for schedule(dynamic,1) if( pcv.widthInCtus > 1 )
+  for( int x = 0; x < pcv.widthInCtus; x++ )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
-    {
-      memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
+    LoopFilter loopFilter( *this );
 
+    for( int y = 0; y < pcv.heightInCtus; y++ )
+    {
       const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
 
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_HOR );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_HOR );
-        }
-      }
+      loopFilter.xDeblockCtu( cs, ctuArea, EDGE_HOR );
     }
   }
 
@@ -228,6 +200,29 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
 // Protected member functions
 // ====================================================================================================================
 
+void LoopFilter::xDeblockCtu( CodingStructure& cs, const UnitArea& ctuArea, const DeblockEdgeDir edgeDir )
+{
+  memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+  memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+
+  // CU-based deblocking
+  for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+  {
+    xDeblockCU( currCU, edgeDir );
+  }
+
+  if( CS::isDualITree( cs ) )
+  {
+    memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+    memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+
+    for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
+    {
+      xDeblockCU( currCU, edgeDir );
+    }
+  }
+}
+
 /**
  Deblocking filter process in CU-based (the same function as conventional's)
 
@@ -60,6 +60,8 @@ private:
   LFCUParam m_stLFCUParam;                   ///< status structure
 
 private:
+  /// CTU-level deblocking of the edges in one direction
+  void xDeblockCtu                ( CodingStructure& cs, const UnitArea& ctuArea, const DeblockEdgeDir edgeDir );
   /// CU-level deblocking function
   void xDeblockCU                 (       CodingUnit& cu, const DeblockEdgeDir edgeDir );
 
@@ -110,9 +110,6 @@ struct MotionInfo
   UShort   sliceIdx;
 
   Mv      mv     [ NUM_REF_PIC_LIST_01 ];
-#if JEM_TOOLS
-  Mv      mvdAffi[ NUM_REF_PIC_LIST_01 ];
-#endif
   Short   refIdx [ NUM_REF_PIC_LIST_01 ];
 
 #if JEM_TOOLS
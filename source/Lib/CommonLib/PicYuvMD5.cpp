@@ -38,25 +38,29 @@
 //! \ingroup CommonLib
 //! \{
 
+/**
+ * Minimum luma area for which the per-component hashes are computed
+ * concurrently; below it the thread start-up dominates the work.
+ */
+static const UInt HASH_PARALLEL_MIN_AREA = 256 * 256;
+
 /**
  * Update md5 using n samples from plane, each sample is adjusted to
  * OUTBIT_BITDEPTH_DIV8.
  */
 template<UInt OUTPUT_BITDEPTH_DIV8>
-static Void md5_block(MD5& md5, const Pel* plane, UInt n)
+static Void md5_block(MD5& md5, UChar* buf, const Pel* plane, UInt n)
 {
-  /* create a 64 byte buffer for packing Pel's into */
-  UChar buf[64/OUTPUT_BITDEPTH_DIV8][OUTPUT_BITDEPTH_DIV8];
+  /* perform bitdepth and endian conversion */
   for (UInt i = 0; i < n; i++)
   {
-    Pel pel = plane[i];
-    /* perform bitdepth and endian conversion */
+    const Pel pel = plane[i];
     for (UInt d = 0; d < OUTPUT_BITDEPTH_DIV8; d++)
     {
-      buf[i][d] = pel >> (d*8);
+      buf[i*OUTPUT_BITDEPTH_DIV8 + d] = pel >> (d*8);
     }
   }
-  md5.update((UChar*)buf, n * OUTPUT_BITDEPTH_DIV8);
+  md5.update(buf, n * OUTPUT_BITDEPTH_DIV8);
 }
 
 /**
@@ -66,97 +70,107 @@ static Void md5_block(MD5& md5, const Pel* plane, UInt n)
 template<UInt OUTPUT_BITDEPTH_DIV8>
 static Void md5_plane(MD5& md5, const Pel* plane, UInt width, UInt height, UInt stride)
 {
-  /* N is the number of samples to process per md5 update.
-   * All N samples must fit in buf */
-  UInt N = 32;
-  UInt width_modN = width % N;
-  UInt width_less_modN = width - width_modN;
+  /* convert pels into unsigned chars in little endian byte order, one line
+   * per md5 update. NB, for 8bit data, data is truncated to 8bits. */
+  std::vector<UChar> buf( width * OUTPUT_BITDEPTH_DIV8 );
 
   for (UInt y = 0; y < height; y++)
   {
-    /* convert pels into unsigned chars in little endian byte order.
-     * NB, for 8bit data, data is truncated to 8bits. */
-    for (UInt x = 0; x < width_less_modN; x += N)
+    md5_block<OUTPUT_BITDEPTH_DIV8>(md5, buf.data(), &plane[y*stride], width);
+  }
+}
+
+/**
+ * Byte-wise lookup table for the CRC-CCITT (0x1021) used by the picture
+ * hash SEI: entry i holds the remainder of shifting the byte i out of the
+ * top of the register.
+ */
+struct CRCTable
+{
+  UShort val[256];
+
+  CRCTable()
+  {
+    for( UInt i = 0; i < 256; i++ )
     {
-      md5_block<OUTPUT_BITDEPTH_DIV8>(md5, &plane[y*stride + x], N);
+      UInt crcVal = i << 8;
+      for( UInt bitIdx = 0; bitIdx < 8; bitIdx++ )
+      {
+        crcVal = ( ( crcVal << 1 ) & 0xffff ) ^ ( ( ( crcVal >> 15 ) & 1 ) * 0x1021 );
+      }
+      val[i] = crcVal;
     }
-
-    /* mop up any of the remaining line */
-    md5_block<OUTPUT_BITDEPTH_DIV8>(md5, &plane[y*stride + width_less_modN], width_modN);
   }
-}
+};
 
+static const CRCTable g_crcTable;
+
+static inline UInt crcByte( UInt crcVal, UInt byteVal )
+{
+  return ( ( ( crcVal << 8 ) | byteVal ) & 0xffff ) ^ g_crcTable.val[crcVal >> 8];
+}
 
 UInt compCRC(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, PictureHash &digest)
 {
-  UInt crcMsb;
-  UInt bitVal;
   UInt crcVal = 0xffff;
-  UInt bitIdx;
   for (UInt y = 0; y < height; y++)
   {
-    for (UInt x = 0; x < width; x++)
+    const Pel* line = plane + y*stride;
+    if(bitdepth > 8)
     {
-      // take CRC of first pictureData byte
-      for(bitIdx=0; bitIdx<8; bitIdx++)
+      // first and second pictureData byte
+      for (UInt x = 0; x < width; x++)
       {
-        crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
-        crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
+        crcVal = crcByte( crcVal,  line[x]        & 0xff );
+        crcVal = crcByte( crcVal, (line[x] >> 8 ) & 0xff );
       }
-      // take CRC of second pictureData byte if bit depth is greater than 8-bits
-      if(bitdepth > 8)
+    }
+    else
+    {
+      for (UInt x = 0; x < width; x++)
       {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
+        crcVal = crcByte( crcVal, line[x] & 0xff );
       }
     }
   }
-  for(bitIdx=0; bitIdx<16; bitIdx++)
-  {
-    crcMsb = (crcVal >> 15) & 1;
-    crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
-  }
+  crcVal = crcByte( crcVal, 0 );
+  crcVal = crcByte( crcVal, 0 );
 
   digest.hash.push_back((crcVal>>8)  & 0xff);
   digest.hash.push_back( crcVal      & 0xff);
   return 2;
 }
 
-UInt calcCRC(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
-{
-  UInt digestLen=0;
-  digest.hash.clear();
-  for (UInt chan = 0; chan< (UInt)pic.bufs.size(); chan++)
-  {
-    const ComponentID compID = ComponentID(chan);
-    const CPelBuf area = pic.get(compID);
-    digestLen = compCRC(bitDepths.recon[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, digest );
-  }
-  return digestLen;
-}
-
 UInt compChecksum(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, PictureHash &digest, const BitDepths &/*bitDepths*/)
 {
   UInt checksum = 0;
-  UChar xor_mask;
+
+  // the xor mask separates into a column and a line term, hoisting it
+  // out of the inner loops leaves plain (vectorizable) sums
+  std::vector<UChar> xMask( width );
+  for (UInt x = 0; x < width; x++)
+  {
+    xMask[x] = (x & 0xff) ^ (x >> 8);
+  }
 
   for (UInt y = 0; y < height; y++)
   {
+    const Pel*  line  = plane + y*stride;
+    const UChar yMask = (y & 0xff) ^ (y >> 8);
+    UInt lineSum      = 0;
+
     for (UInt x = 0; x < width; x++)
     {
-      xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
-      checksum = (checksum + ((plane[y*stride+x] & 0xff) ^ xor_mask)) & 0xffffffff;
-
-      if(bitdepth > 8)
+      lineSum += (line[x] & 0xff) ^ xMask[x] ^ yMask;
+    }
+    if(bitdepth > 8)
+    {
+      for (UInt x = 0; x < width; x++)
       {
-        checksum = (checksum + ((plane[y*stride+x]>>8) ^ xor_mask)) & 0xffffffff;
+        lineSum += ((line[x] >> 8) & 0xff) ^ xMask[x] ^ yMask;
       }
     }
+    checksum += lineSum;
   }
 
   digest.hash.push_back((checksum>>24) & 0xff);
@@ -166,17 +180,48 @@ UInt compChecksum(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt
   return 4;
 }
 
-UInt calcChecksum(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
+/**
+ * Apply a per-component hash function to all planes of pic and concatenate
+ * the results in component order. The planes are independent, so for large
+ * pictures they are hashed concurrently.
+ */
+template<typename PlaneHashFunc>
+static UInt calcPlaneHashes(const CPelUnitBuf& pic, PictureHash &digest, PlaneHashFunc planeHash)
 {
-  UInt digestLen=0;
+  const Int   numComp = (Int)pic.bufs.size();
+  PictureHash compDigest[MAX_NUM_COMPONENT];
+  UInt        digestLen[MAX_NUM_COMPONENT] = { 0 };
+  const Bool  doParallel = numComp > 1 && pic.bufs[0].area() >= HASH_PARALLEL_MIN_AREA;
+
+#pragma omp parallel for schedule(static,1) num_threads(numComp) if(doParallel)
+  for (Int chan = 0; chan < numComp; chan++)
+  {
+    const ComponentID compID = ComponentID(chan);
+    digestLen[chan] = planeHash(compID, pic.get(compID), compDigest[chan]);
+  }
+
   digest.hash.clear();
-  for(UInt chan=0; chan< (UInt)pic.bufs.size(); chan++)
+  for (Int chan = 0; chan < numComp; chan++)
   {
-    const ComponentID compID=ComponentID(chan);
-    const CPelBuf area = pic.get(compID);
-    digestLen=compChecksum(bitDepths.recon[toChannelType(compID)], area.bufAt(0,0), area.width, area.height, area.stride, digest, bitDepths);
+    digest.hash.insert(digest.hash.end(), compDigest[chan].hash.begin(), compDigest[chan].hash.end());
   }
-  return digestLen;
+  return numComp > 0 ? digestLen[numComp - 1] : 0;
+}
+
+UInt calcCRC(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
+{
+  return calcPlaneHashes(pic, digest, [&bitDepths](const ComponentID compID, const CPelBuf& area, PictureHash& compDigest)
+  {
+    return compCRC(bitDepths.recon[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, compDigest);
+  });
+}
+
+UInt calcChecksum(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
+{
+  return calcPlaneHashes(pic, digest, [&bitDepths](const ComponentID compID, const CPelBuf& area, PictureHash& compDigest)
+  {
+    return compChecksum(bitDepths.recon[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, compDigest, bitDepths);
+  });
 }
 /**
  * Calculate the MD5sum of pic, storing the result in digest.
@@ -187,28 +232,19 @@ UInt calcChecksum(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &
  */
 UInt calcMD5(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
 {
-  /* choose an md5_plane packing function based on the system bitdepth */
-  typedef Void (*MD5PlaneFunc)(MD5&, const Pel*, UInt, UInt, UInt);
-  MD5PlaneFunc md5_plane_func;
-
-  MD5 md5[MAX_NUM_COMPONENT];
-
-  digest.hash.clear();
-
-  for (UInt chan = 0; chan< (UInt)pic.bufs.size(); chan++)
+  return calcPlaneHashes(pic, digest, [&bitDepths](const ComponentID compID, const CPelBuf& area, PictureHash& compDigest)
   {
-    const ComponentID compID=ComponentID(chan);
-    const CPelBuf area = pic.get(compID);
-    md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
+    /* choose an md5_plane packing function based on the system bitdepth */
+    typedef Void (*MD5PlaneFunc)(MD5&, const Pel*, UInt, UInt, UInt);
+    MD5PlaneFunc md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
+
+    MD5   md5;
     UChar tmp_digest[MD5_DIGEST_STRING_LENGTH];
-    md5_plane_func(md5[compID], area.bufAt(0, 0), area.width, area.height, area.stride );
-    md5[compID].finalize(tmp_digest);
-    for(UInt i=0; i<MD5_DIGEST_STRING_LENGTH; i++)
-    {
-      digest.hash.push_back(tmp_digest[i]);
-    }
-  }
-  return 16;
+    md5_plane_func(md5, area.bufAt(0, 0), area.width, area.height, area.stride );
+    md5.finalize(tmp_digest);
+    compDigest.hash.assign(tmp_digest, tmp_digest + MD5_DIGEST_STRING_LENGTH);
+    return 16u;
+  });
 }
 
 std::string hashToString(const PictureHash &digest, Int numChar)
@@ -724,6 +724,7 @@ Picture::Picture()
   layer                = std::numeric_limits<UInt>::max();
   fieldPic             = false;
   topField             = false;
+  wpAcDcValid          = false;
   for( int i = 0; i < MAX_NUM_CHANNEL_TYPE; i++ )
   {
     m_prevQP[i] = -1;
@@ -899,6 +900,13 @@ Void Picture::finalInit( const SPS& sps, const PPS& pps )
 #endif
   cs->pcv     = pps.pcv;
 
+  wpAcDcValid = false;
+  for( int comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+  {
+    wpHistOrg[comp].clear();
+    wpHistRec[comp].clear();
+  }
+
 #if HEVC_TILES_WPP
   tileMap = new TileMap;
   tileMap->create( sps, pps );
@@ -263,6 +263,13 @@ public:
 #endif
   std::vector<AQpLayer*> aqlayer;
 
+  // weighted prediction analysis of the whole picture, shared by its slices and by the pictures referencing it
+  // filled on first use and reset by finalInit, the reconstruction histograms are filled through the const reference pictures
+  WPACDCParam              wpAcDcParam[MAX_NUM_COMPONENT];
+  Bool                     wpAcDcValid;
+  std::vector<Int>         wpHistOrg  [MAX_NUM_COMPONENT];
+  mutable std::vector<Int> wpHistRec  [MAX_NUM_COMPONENT];
+
 #if !KEEP_PRED_AND_RESI_SIGNALS
 private:
   UnitArea m_ctuArea;
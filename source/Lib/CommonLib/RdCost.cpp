@@ -49,6 +49,9 @@
 
 
 FpDistFunc RdCost::m_afpDistortFunc[DF_TOTAL_FUNCTIONS] = { nullptr, };
+#if JEM_TOOLS
+FpDistWindowFunc RdCost::m_fpSADWindow = nullptr;
+#endif
 
 RdCost::RdCost()
 {
@@ -130,6 +133,9 @@ Void RdCost::init()
   m_afpDistortFunc[DF_SAD12  ] = RdCost::xGetSAD12;
   m_afpDistortFunc[DF_SAD24  ] = RdCost::xGetSAD24;
   m_afpDistortFunc[DF_SAD48  ] = RdCost::xGetSAD48;
+#if JEM_TOOLS
+  m_fpSADWindow                = RdCost::xGetSADWindow;
+#endif
 
   m_afpDistortFunc[DF_HAD    ] = RdCost::xGetHADs;
   m_afpDistortFunc[DF_HAD2   ] = RdCost::xGetHADs;
@@ -494,6 +500,42 @@ Distortion RdCost::xGetSAD( const DistParam& rcDtParam )
   return ( uiSum >> distortionShift );
 }
 
+#if JEM_TOOLS
+Void RdCost::xGetSADWindow( const DistParam& rcDtParam, Int range, Distortion* dist )
+{
+  CHECK( rcDtParam.applyWeight || rcDtParam.subShift, "Not supported" );
+
+  const Int  iCols           = rcDtParam.org.width;
+  const Int  iRows           = rcDtParam.org.height;
+  const Int  iStrideCur      = rcDtParam.cur.stride;
+  const Int  iStrideOrg      = rcDtParam.org.stride;
+  const UInt distortionShift = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth - 8);
+
+  for( Int dy = -range; dy <= range; dy++ )
+  {
+    for( Int dx = -range; dx <= range; dx++ )
+    {
+      const Pel* piOrg = rcDtParam.org.buf;
+      const Pel* piCur = rcDtParam.cur.buf + dy * iStrideCur + dx;
+
+      Distortion uiSum = 0;
+
+      for( Int y = 0; y < iRows; y++ )
+      {
+        for( Int n = 0; n < iCols; n++ )
+        {
+          uiSum += abs( piOrg[n] - piCur[n] );
+        }
+        piOrg += iStrideOrg;
+        piCur += iStrideCur;
+      }
+
+      *dist++ = uiSum >> distortionShift;
+    }
+  }
+}
+
+#endif
 Distortion RdCost::xGetSAD4( const DistParam& rcDtParam )
 {
   if ( rcDtParam.applyWeight )
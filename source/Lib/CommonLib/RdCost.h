@@ -58,6 +58,9 @@ class EncCfg;
 
 // for function pointer
 typedef Distortion (*FpDistFunc) (const DistParam&);
+#if JEM_TOOLS
+typedef Void       (*FpDistWindowFunc) (const DistParam&, Int, Distortion*);
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -99,6 +102,9 @@ private:
   // for distortion
 
   static FpDistFunc       m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+#if JEM_TOOLS
+  static FpDistWindowFunc m_fpSADWindow;
+#endif
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -153,6 +159,10 @@ public:
   Void           setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRefY , Int iRefStride, Int bitDepth, ComponentID compID, Int subShiftMode = 0, Int step = 1, Bool useHadamard = false );
   Void           setDistParam( DistParam &rcDP, const CPelBuf &org, const CPelBuf &cur, Int bitDepth, ComponentID compID, Bool useHadamard = false );
   Void           setDistParam( DistParam &rcDP, const Pel* pOrg, const Pel* piRefY, Int iOrgStride, Int iRefStride, Int bitDepth, ComponentID compID, Int width, Int height, Int subShiftMode = 0, Int step = 1, Bool useHadamard = false );
+#if JEM_TOOLS
+  // SAD of all integer displacements of cur within +-range around its position, in raster order
+  Void           getSADWindow( const DistParam &rcDP, Int range, Distortion* dist ) { m_fpSADWindow( rcDP, range, dist ); }
+#endif
 
   double         getMotionLambda          ( bool bIsTransquantBypass ) { return m_dLambdaMotionSAD[(bIsTransquantBypass && m_costMode==COST_MIXED_LOSSLESS_LOSSY_CODING)?1:0]; }
   Void           selectMotionLambda       ( bool bIsTransquantBypass ) { m_motionLambda = getMotionLambda( bIsTransquantBypass ); }
@@ -239,6 +249,9 @@ private:
   static Distortion xGetSAD48         ( const DistParam& pcDtParam );
 
   static Distortion xGetSAD_full      ( const DistParam& pcDtParam );
+#if JEM_TOOLS
+  static Void       xGetSADWindow     ( const DistParam& pcDtParam, Int range, Distortion* dist );
+#endif
 
   static Distortion xGetMRSAD         ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD4        ( const DistParam& pcDtParam );
@@ -272,6 +285,10 @@ private:
   static Distortion xGetSAD_SIMD    ( const DistParam& pcDtParam );
   template< Int iWidth, X86_VEXT vext >
   static Distortion xGetSAD_NxN_SIMD( const DistParam& pcDtParam );
+#if JEM_TOOLS
+  template< X86_VEXT vext >
+  static Void       xGetSADWindow_SIMD( const DistParam& pcDtParam, Int range, Distortion* dist );
+#endif
 
   template< typename Torg, typename Tcur, X86_VEXT vext >
   static Distortion xGetHADs_SIMD   ( const DistParam& pcDtParam );
@@ -219,6 +219,8 @@
 #define ENABLE_SIMD_OPT_MCIF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the interpolation filter, no impact on RD performance
 #define ENABLE_SIMD_OPT_BUFFER                          ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the buffer operations, no impact on RD performance
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
+#define ENABLE_SIMD_OPT_CCLM                            ( 1 && ENABLE_SIMD_OPT && JEM_TOOLS )               ///< SIMD optimization for the cross-component linear model prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_BIF                             ( 1 && ENABLE_SIMD_OPT && JEM_TOOLS )               ///< SIMD optimization for the bilateral filter, no impact on RD performance
 // End of SIMD optimizations
 
 #define AMP_ENC_SPEEDUP                                   0 ///< encoder only speed-up by AMP mode skipping
@@ -1413,24 +1415,30 @@ public:
 // dynamic cache
 // ---------------------------------------------------------------------------
 
+// Elements are carved out of contiguous slabs and recycled through a free list. Elements returned in bulk are handed
+// out again in the order they were returned, so units allocated in coding order stay in coding order in memory.
 template<typename T>
 class dynamic_cache
 {
+  static const size_t SLAB_SIZE = 128;
+
   std::vector<T*> m_cache;
+  std::vector<T*> m_slabs;
+  size_t          m_slabPos;
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   int64_t         m_cacheId;
 #endif
 
 public:
 
-#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-  dynamic_cache()
+  dynamic_cache() : m_slabPos( SLAB_SIZE )
   {
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
     static int cacheId = 0;
     m_cacheId = cacheId++;
+#endif
   }
 
-#endif
   ~dynamic_cache()
   {
     deleteEntries();
@@ -1438,13 +1446,15 @@ public:
 
   void deleteEntries()
   {
-    for( auto &p : m_cache )
+    for( auto &p : m_slabs )
     {
-      delete p;
+      delete[] p;
       p = nullptr;
     }
 
+    m_slabs.clear();
     m_cache.clear();
+    m_slabPos = SLAB_SIZE;
   }
 
   T* get()
@@ -1462,7 +1472,13 @@ public:
     }
     else
     {
-      ret = new T;
+      if( m_slabPos == SLAB_SIZE )
+      {
+        m_slabs.push_back( new T[SLAB_SIZE] );
+        m_slabPos = 0;
+      }
+
+      ret = &m_slabs.back()[m_slabPos++];
     }
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
@@ -1497,7 +1513,8 @@ public:
     }
 
 #endif
-    m_cache.insert( m_cache.end(), vel.begin(), vel.end() );
+    // reversed, the first element of the list is the next one to be fetched
+    m_cache.insert( m_cache.end(), vel.rbegin(), vel.rend() );
     vel.clear();
   }
 };
@@ -351,6 +351,10 @@ Void PredictionUnit::initData()
     refIdx[i] = -1;
     mv[i]     .setZero();
     mvd[i]    .setZero();
+#if JEM_TOOLS
+    mvdAffi[i][0].setZero();
+    mvdAffi[i][1].setZero();
+#endif
   }
 }
 
@@ -381,6 +385,10 @@ PredictionUnit& PredictionUnit::operator=(const InterPredictionData& predData)
     mv[i]       = predData.mv[i];
     mvd[i]      = predData.mvd[i];
     refIdx[i]   = predData.refIdx[i];
+#if JEM_TOOLS
+    mvdAffi[i][0] = predData.mvdAffi[i][0];
+    mvdAffi[i][1] = predData.mvdAffi[i][1];
+#endif
   }
 
   return *this;
@@ -408,6 +416,10 @@ PredictionUnit& PredictionUnit::operator=( const PredictionUnit& other )
     mv[i]       = other.mv[i];
     mvd[i]      = other.mvd[i];
     refIdx[i]   = other.refIdx[i];
+#if JEM_TOOLS
+    mvdAffi[i][0] = other.mvdAffi[i][0];
+    mvdAffi[i][1] = other.mvdAffi[i][1];
+#endif
   }
 
   return *this;
@@ -369,6 +369,7 @@ struct InterPredictionData
 #if JEM_TOOLS
   UChar     frucMrgMode;
   Bool      mvRefine;
+  Mv        mvdAffi [NUM_REF_PIC_LIST_01][2];  ///< affine control point mvds of the left-top and right-top corners
 #endif
 };
 
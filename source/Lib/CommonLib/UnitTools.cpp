@@ -76,22 +76,17 @@ UInt64 CS::getEstBits(const CodingStructure &cs)
 #if JEM_TOOLS
 static void xInitFrucMvpEl( CodingStructure& cs, Int x, Int y, Int nCurPOC, Int nTargetRefIdx, Int nTargetRefPOC, Int nCurRefIdx, Int nCurRefPOC, Int nColPOC, RefPicList eRefPicList, const Picture* pColPic )
 {
-  const unsigned scale = ( cs.pcv->noMotComp ? 1 : 4 * std::max<Int>( 1, 4 * AMVP_DECIMATION_FACTOR / 4 ) );
+  CHECK( x >= cs.picture->Y().width || y >= cs.picture->Y().height, "size exceed" );
 
-  const unsigned mask = ~( scale - 1 );
+  const ColMotionField &colMotion = pColPic->cs->getColMotion();
+  const unsigned        colIdx    = colMotion.idx( Position{ x, y } );
 
-  const Position pos = Position{ PosType( x & mask ), PosType( y & mask ) };
-
-  CHECK( pos.x >= cs.picture->Y().width || pos.y >= cs.picture->Y().height, "size exceed" );
-
-  const MotionInfo &frucMi = pColPic->cs->getMotionInfo( pos );
-
-  if( frucMi.interDir & ( 1 << eRefPicList ) )
+  if( colMotion.interDir( colIdx ) & ( 1 << eRefPicList ) )
   {
-    CHECK( frucMi.isInter == false && frucMi.interDir < 1, "invalid motion info" );
+    CHECK( !colMotion.isInter( colIdx ) && colMotion.interDir( colIdx ) < 1, "invalid motion info" );
 
-    Int nColRefPOC = pColPic->cs->slice->getRefPOC( eRefPicList, frucMi.refIdx[eRefPicList] );
-    Mv mvColPic = frucMi.mv[eRefPicList];
+    Int nColRefPOC = pColPic->cs->slice->getRefPOC( eRefPicList, colMotion.refIdx[eRefPicList][colIdx] );
+    Mv mvColPic = colMotion.mv[eRefPicList][colIdx];
     if( cs.sps->getSpsNext().getUseHighPrecMv() )
     {
       mvColPic.setHighPrec();
@@ -1649,12 +1644,6 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList, const Position &_pos, Mv& rcMv, const int &refIdx )
 #endif
 {
-  // don't perform MV compression when generally disabled or subPuMvp is used
-  const unsigned scale = ( pu.cs->pcv->noMotComp ? 1 : 4 * std::max<Int>(1, 4 * AMVP_DECIMATION_FACTOR / 4) );
-  const unsigned mask  = ~( scale - 1 );
-
-  const Position pos = Position{ PosType( _pos.x & mask ), PosType( _pos.y & mask ) };
-
   const Slice &slice = *pu.cs->slice;
 
   // use coldir.
@@ -1667,19 +1656,21 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
   RefPicList eColRefPicList = slice.getCheckLDC() ? eRefPicList : RefPicList(slice.getColFromL0Flag());
 
-  const MotionInfo& mi = pColPic->cs->getMotionInfo( pos );
+  // the collocated motion field is stored compressed, unless compression is generally disabled or subPuMvp is used
+  const ColMotionField& colMotion = pColPic->cs->getColMotion();
+  const unsigned        colIdx    = colMotion.idx( _pos );
 
-  if( !mi.isInter )
+  if( !colMotion.isInter( colIdx ) )
   {
     return false;
   }
 
-  int iColRefIdx = mi.refIdx[eColRefPicList];
+  int iColRefIdx = colMotion.refIdx[eColRefPicList][colIdx];
 
   if (iColRefIdx < 0)
   {
     eColRefPicList = RefPicList(1 - eColRefPicList);
-    iColRefIdx = mi.refIdx[eColRefPicList];
+    iColRefIdx = colMotion.refIdx[eColRefPicList][colIdx];
 
     if (iColRefIdx < 0)
     {
@@ -1691,7 +1682,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 
   for( const auto s : pColPic->slices )
   {
-    if( s->getIndependentSliceIdx() == mi.sliceIdx )
+    if( s->getIndependentSliceIdx() == colMotion.sliceIdx[colIdx] )
     {
       pColSlice = s;
       break;
@@ -1713,12 +1704,12 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
 #if JEM_TOOLS
   if( LICFlag )
   {
-    *LICFlag = mi.usesLIC;
+    *LICFlag = colMotion.usesLIC( colIdx );
   }
 #endif
 
   // Scale the vector.
-  Mv cColMv = mi.mv[eColRefPicList];
+  Mv cColMv = colMotion.mv[eColRefPicList][colIdx];
 
   if (bIsCurrRefLongTerm /*|| bIsColRefLongTerm*/)
   {
@@ -2418,12 +2409,13 @@ static bool deriveScaledMotionTemporal( const Slice&      slice,
                                               bool&       LICFlag,
                                         const RefPicList  eFetchRefPicList )
 {
-  const MotionInfo &mi    = pColPic->cs->getMotionInfo( colPos );
+  const ColMotionField &colMotion = pColPic->cs->getColMotion();
+  const unsigned        colIdx    = colMotion.idx( colPos );
   const Slice *pColSlice  = nullptr;
 
   for( const auto &pSlice : pColPic->slices )
   {
-    if( pSlice->getIndependentSliceIdx() == mi.sliceIdx )
+    if( pSlice->getIndependentSliceIdx() == colMotion.sliceIdx[colIdx] )
     {
       pColSlice = pSlice;
       break;
@@ -2452,12 +2444,12 @@ static bool deriveScaledMotionTemporal( const Slice&      slice,
   // Grab motion and do necessary scaling.{{
   iCurrPOC = slice.getPOC();
 
-  int iColRefIdx = mi.refIdx[eColRefPicList];
+  int iColRefIdx = colMotion.refIdx[eColRefPicList][colIdx];
 
   if( iColRefIdx < 0 && ( slice.getCheckLDC() || bAllowMirrorMV ) && !slice.getSPS()->getSpsNext().getUseFRUCMrgMode() )
   {
     eColRefPicList = RefPicList( 1 - eColRefPicList );
-    iColRefIdx = mi.refIdx[eColRefPicList];
+    iColRefIdx = colMotion.refIdx[eColRefPicList][colIdx];
 
     if( iColRefIdx < 0 )
     {
@@ -2474,7 +2466,7 @@ static bool deriveScaledMotionTemporal( const Slice&      slice,
     ///////////////////////////////////////////////////////////////
     iCurrRefPOC = slice.getRefPic( eCurrRefPicList, 0 )->getPOC();
     // Scale the vector.
-    cColMv      = mi.mv[eColRefPicList];
+    cColMv      = colMotion.mv[eColRefPicList][colIdx];
     //pcMvFieldSP[2*iPartition + eCurrRefPicList].getMv();
     // Assume always short-term for now
     iScale      = xGetDistScaleFactor( iCurrPOC, iCurrRefPOC, iColPOC, iColRefPOC );
@@ -2489,7 +2481,7 @@ static bool deriveScaledMotionTemporal( const Slice&      slice,
       cColMv    = cColMv.scaleMv( iScale );
     }
 
-    LICFlag = mi.usesLIC;
+    LICFlag = colMotion.usesLIC( colIdx );
 
     return true;
   }
@@ -2599,9 +2591,9 @@ bool PU::getInterMergeSubPuMvpCand( const PredictionUnit &pu, MergeCtx& mrgCtx,
       centerPos.y = Clip3( 0, ( int ) pColPic->lheight() - 1, centerPos.y );
 
       // derivation of center motion parameters from the collocated CU
-      const MotionInfo &mi = pColPic->cs->getMotionInfo( centerPos );
+      const ColMotionField &colMotion = pColPic->cs->getColMotion();
 
-      if( mi.isInter )
+      if( colMotion.isInter( colMotion.idx( centerPos ) ) )
       {
         for( UInt uiCurrRefListId = 0; uiCurrRefListId < ( bBSlice ? 2 : 1 ); uiCurrRefListId++ )
         {
@@ -2653,14 +2645,14 @@ bool PU::getInterMergeSubPuMvpCand( const PredictionUnit &pu, MergeCtx& mrgCtx,
       colPos.x = Clip3( 0, iPicWidth, colPos.x );
       colPos.y = Clip3( 0, iPicHeight, colPos.y );
 
-      const MotionInfo &colMi = pColPic->cs->getMotionInfo( colPos );
+      const ColMotionField &colMotion = pColPic->cs->getColMotion();
 
       MotionInfo mi;
 
       mi.isInter  = true;
       mi.sliceIdx = slice.getIndependentSliceIdx();
 
-      if( colMi.isInter )
+      if( colMotion.isInter( colMotion.idx( colPos ) ) )
       {
         for( UInt uiCurrRefListId = 0; uiCurrRefListId < ( bBSlice ? 2 : 1 ); uiCurrRefListId++ )
         {
@@ -3347,36 +3339,10 @@ Void PU::setAllAffineMv( PredictionUnit& pu, Mv affLT, Mv affRT, Mv affLB, RefPi
   mb.at( mb.width - 1, mb.height - 1 ).mv[eRefList] = mv;
 }
 
-Void PU::setAllAffineMvd( MotionBuf mb, const Mv& affLT, const Mv& affRT, RefPicList eRefList, Bool rectCUs )
+Void PU::setAffineMvd( PredictionUnit &pu, const Mv& affLT, const Mv& affRT, RefPicList eRefList )
 {
-  // Set all partitions (possibly unnecessarily set)
-  Mv mvd;
-  if( rectCUs )
-  {
-    mvd = affLT + affRT;
-  }
-  else
-  {
-    mvd = affRT;
-  }
-  mvd.setHighPrec();
-  mvd >>= 1;
-  for (UInt y = 0; y < mb.height; y++)
-  {
-    for (UInt x = 0; x < mb.width; x++)
-    {
-      mb.at(x,y).mvdAffi[eRefList] = mvd;
-    }
-  }
-
-  // Overwrite corner partitions
-  mb.at(          0, 0 ).mvdAffi[eRefList] = affLT;
-  mb.at( mb.width-1, 0 ).mvdAffi[eRefList] = affRT;
-  if( !rectCUs )
-  {
-    mb.at(          0, mb.height-1 ).mvdAffi[eRefList] = Mv( 0, 0 );
-    mb.at( mb.width-1, mb.height-1 ).mvdAffi[eRefList] = affRT - affLT;
-  }
+  pu.mvdAffi[eRefList][0] = affLT;
+  pu.mvdAffi[eRefList][1] = affRT;
 }
 #endif
 
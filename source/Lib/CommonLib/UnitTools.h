@@ -153,7 +153,7 @@ namespace PU
   void getAffineMergeCand             (const PredictionUnit &pu, MvField (*mvFieldNeighbours)[3], unsigned char &interDirNeighbours, int &numValidMergeCand );
   void setAllAffineMvField            (      PredictionUnit &pu, MvField *mvField, RefPicList eRefList );
   void setAllAffineMv                 (      PredictionUnit &pu, Mv affLT, Mv affRT, Mv affLB, RefPicList eRefList );
-  void setAllAffineMvd                (      MotionBuf mb, const Mv& affLT, const Mv& affRT, RefPicList eRefList, Bool useQTBT );
+  void setAffineMvd                   (      PredictionUnit &pu, const Mv& affLT, const Mv& affRT, RefPicList eRefList );
   bool isBIOLDB                       (const PredictionUnit &pu);
 #endif
   bool isBiPredFromDifferentDir       (const PredictionUnit &pu);
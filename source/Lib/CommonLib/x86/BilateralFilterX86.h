@@ -0,0 +1,214 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     BilateralFilterX86.h
+    \brief    SIMD for the bilateral filter
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/BilateralFilter.h"
+
+#if ENABLE_SIMD_OPT_BIF
+#ifdef TARGET_SIMD_X86
+
+#ifdef USE_AVX2
+// the weight and division LUTs are indexed per sample, so the kernel needs the AVX2 gathers and the
+// per lane (variable) shifts; the unsigned 32 bit arithmetic of the scalar implementation is kept bit exact
+template< X86_VEXT vext >
+void smoothBlockBilateralFilter_AVX2( short block[], int width, int height, int centerWeight, const unsigned short* lookupTable, int theMaxPos, const unsigned* divToMulOneOverN, const int* divToMulShift )
+{
+  // un-filtered copy of the current and the previous row, with one spare sample in front and 8 behind
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, short rowBuf[2][MAX_CU_SIZE + 16] );
+
+  short* cur  = rowBuf[0] + 8;
+  short* prev = rowBuf[1] + 8;
+
+  const __m256i vzero256     = _mm256_setzero_si256();
+  const __m256i vlutMask256  = _mm256_set1_epi32( 0xffff );
+  const __m256i vmaxPos256   = _mm256_set1_epi32( theMaxPos );
+  const __m256i vcenterW256  = _mm256_set1_epi32( centerWeight );
+  const __m256i vdivBits256  = _mm256_set1_epi32( BITS_PER_DIV_LUT_ENTRY );
+  const __m256i vlastCol256  = _mm256_set1_epi32( width - 1 );
+  const __m256i vlaneIdx256  = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+  const __m128i vzero        = _mm_setzero_si128();
+  const __m128i vlutMask     = _mm_set1_epi32( 0xffff );
+  const __m128i vmaxPos      = _mm_set1_epi32( theMaxPos );
+  const __m128i vcenterW     = _mm_set1_epi32( centerWeight );
+  const __m128i vdivBits     = _mm_set1_epi32( BITS_PER_DIV_LUT_ENTRY );
+  const __m128i vlastCol     = _mm_set1_epi32( width - 1 );
+  const __m128i vlaneIdx     = _mm_setr_epi32( 0, 1, 2, 3 );
+
+  for( int y = 0; y < height; y++ )
+  {
+    short* row = block + y * width;
+
+    memcpy( cur, row, width * sizeof( short ) );
+    cur[-1]    = 0;
+    cur[width] = 0;
+
+    // missing neighbours are read from the current row and masked out with a zero weight
+    const bool   hasAbove = y > 0;
+    const bool   hasBelow = y + 1 < height;
+    const short* above    = hasAbove ? prev : cur;
+    const short* below    = hasBelow ? row + width : cur;
+
+    const __m256i vaboveMask256 = hasAbove ? _mm256_set1_epi32( -1 ) : vzero256;
+    const __m256i vbelowMask256 = hasBelow ? _mm256_set1_epi32( -1 ) : vzero256;
+    const __m128i vaboveMask    = hasAbove ? _mm_set1_epi32( -1 ) : vzero;
+    const __m128i vbelowMask    = hasBelow ? _mm_set1_epi32( -1 ) : vzero;
+
+    int x = 0;
+
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m256i vidx   = _mm256_add_epi32( _mm256_set1_epi32( x ), vlaneIdx256 );
+      const __m256i vc     = _mm256_cvtepi16_epi32( _mm_load_si128 ( ( const __m128i* ) &cur[x] ) );
+
+      __m256i vd[4], vw[4];
+      vd[0] = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &cur  [x - 1] ) ), vc );
+      vd[1] = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &cur  [x + 1] ) ), vc );
+      vd[2] = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &above[x]     ) ), vc );
+      vd[3] = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &below[x]     ) ), vc );
+
+      const __m256i vmask[4] = { _mm256_cmpgt_epi32( vidx, vzero256 ), _mm256_cmpgt_epi32( vlastCol256, vidx ), vaboveMask256, vbelowMask256 };
+
+      __m256i vsumW = vcenterW256;
+      __m256i vsumD = vzero256;
+
+      for( int k = 0; k < 4; k++ )
+      {
+        const __m256i vpos = _mm256_min_epi32( _mm256_abs_epi32( vd[k] ), vmaxPos256 );
+        vw[k] = _mm256_i32gather_epi32( ( const int* ) lookupTable, vpos, 2 );
+        vw[k] = _mm256_and_si256( _mm256_and_si256( vw[k], vlutMask256 ), vmask[k] );
+        vsumW = _mm256_add_epi32( vsumW, vw[k] );
+        vsumD = _mm256_add_epi32( vsumD, _mm256_mullo_epi32( vw[k], vd[k] ) );
+      }
+
+      const __m256i vsign  = _mm256_srai_epi32( vsumD, 31 );
+      const __m256i vnum   = _mm256_add_epi32( _mm256_abs_epi32( vsumD ), _mm256_srai_epi32( _mm256_add_epi32( vsumW, vsign ), 1 ) );
+      const __m256i vdiv   = _mm256_i32gather_epi32( ( const int* ) divToMulOneOverN, vsumW, 4 );
+      const __m256i vshift = _mm256_add_epi32( _mm256_i32gather_epi32( divToMulShift, vsumW, 4 ), vdivBits256 );
+
+      __m256i vres = _mm256_srlv_epi32( _mm256_mullo_epi32( vnum, vdiv ), vshift );
+      vres = _mm256_add_epi32( vc, _mm256_sub_epi32( _mm256_xor_si256( vres, vsign ), vsign ) );
+      // truncate to 16 bit like the assignment in the scalar code, packs would saturate
+      vres = _mm256_srai_epi32( _mm256_slli_epi32( vres, 16 ), 16 );
+
+      _mm_storeu_si128( ( __m128i* ) &row[x], _mm_packs_epi32( _mm256_castsi256_si128( vres ), _mm256_extracti128_si256( vres, 1 ) ) );
+    }
+
+    for( ; x + 4 <= width; x += 4 )
+    {
+      const __m128i vidx   = _mm_add_epi32( _mm_set1_epi32( x ), vlaneIdx );
+      const __m128i vc     = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &cur[x] ) );
+
+      __m128i vd[4], vw[4];
+      vd[0] = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &cur  [x - 1] ) ), vc );
+      vd[1] = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &cur  [x + 1] ) ), vc );
+      vd[2] = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &above[x]     ) ), vc );
+      vd[3] = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &below[x]     ) ), vc );
+
+      const __m128i vmask[4] = { _mm_cmpgt_epi32( vidx, vzero ), _mm_cmpgt_epi32( vlastCol, vidx ), vaboveMask, vbelowMask };
+
+      __m128i vsumW = vcenterW;
+      __m128i vsumD = vzero;
+
+      for( int k = 0; k < 4; k++ )
+      {
+        const __m128i vpos = _mm_min_epi32( _mm_abs_epi32( vd[k] ), vmaxPos );
+        vw[k] = _mm_i32gather_epi32( ( const int* ) lookupTable, vpos, 2 );
+        vw[k] = _mm_and_si128( _mm_and_si128( vw[k], vlutMask ), vmask[k] );
+        vsumW = _mm_add_epi32( vsumW, vw[k] );
+        vsumD = _mm_add_epi32( vsumD, _mm_mullo_epi32( vw[k], vd[k] ) );
+      }
+
+      const __m128i vsign  = _mm_srai_epi32( vsumD, 31 );
+      const __m128i vnum   = _mm_add_epi32( _mm_abs_epi32( vsumD ), _mm_srai_epi32( _mm_add_epi32( vsumW, vsign ), 1 ) );
+      const __m128i vdiv   = _mm_i32gather_epi32( ( const int* ) divToMulOneOverN, vsumW, 4 );
+      const __m128i vshift = _mm_add_epi32( _mm_i32gather_epi32( divToMulShift, vsumW, 4 ), vdivBits );
+
+      __m128i vres = _mm_srlv_epi32( _mm_mullo_epi32( vnum, vdiv ), vshift );
+      vres = _mm_add_epi32( vc, _mm_sub_epi32( _mm_xor_si128( vres, vsign ), vsign ) );
+      vres = _mm_srai_epi32( _mm_slli_epi32( vres, 16 ), 16 );
+
+      _mm_storel_epi64( ( __m128i* ) &row[x], _mm_packs_epi32( vres, vres ) );
+    }
+
+    for( ; x < width; x++ )
+    {
+      const int center  = cur[x];
+      const int delta[4] = { cur[x - 1] - center, cur[x + 1] - center, above[x] - center, below[x] - center };
+      const bool avail[4] = { x > 0, x + 1 < width, hasAbove, hasBelow };
+
+      int sumWeights = centerWeight;
+      int sumDelta   = 0;
+
+      for( int k = 0; k < 4; k++ )
+      {
+        const int weight = avail[k] ? lookupTable[std::min( theMaxPos, abs( delta[k] ) )] : 0;
+        sumWeights += weight;
+        sumDelta   += weight * delta[k];
+      }
+
+      const int mySignIfNeg = SIGN_IF_NEG( sumDelta );
+      const int mySign      = 1 | mySignIfNeg;
+
+      row[x] = center + mySign*((((mySign*sumDelta + ((sumWeights+mySignIfNeg) >> 1))*divToMulOneOverN[sumWeights]) >> (BITS_PER_DIV_LUT_ENTRY + divToMulShift[sumWeights])));
+    }
+
+    std::swap( cur, prev );
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void BilateralFilter::_initBilateralFilterX86()
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    m_smoothBlock = smoothBlockBilateralFilter_AVX2<vext>;
+  }
+#endif
+}
+
+template void BilateralFilter::_initBilateralFilterX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
@@ -43,6 +43,7 @@
 #include "CommonDefX86.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/Buffer.h"
+#include "CommonLib/InterpolationFilter.h"
 
 
 #if ENABLE_SIMD_OPT_BUFFER
@@ -362,6 +363,497 @@ Void linTf_SSE_entry( const Pel* src, Int srcStride, Pel *dst, Int dstStride, In
   }
 }
 
+#if JEM_TOOLS
+template< X86_VEXT vext >
+Void obmcBlendHor_SSE( Pel *dst, Int dstStride, const Pel* src, Int srcStride, Int width, Int numLines, bool subtract )
+{
+  for( Int line = 0; line < numLines; line++ )
+  {
+    const Int     shift   = line + 2;
+    const Int     offset  = 1 << ( line + 1 );
+    const __m128i vshift  = _mm_cvtsi32_si128( shift );
+    const __m128i voffset = _mm_set1_epi16   ( offset );
+
+    Int col = 0;
+
+#if USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i voffset256 = _mm256_set1_epi16( offset );
+
+      for( ; col + 16 <= width; col += 16 )
+      {
+        __m256i vdst = _mm256_loadu_si256( ( const __m256i * )&dst[col] );
+        __m256i vsrc = _mm256_loadu_si256( ( const __m256i * )&src[col] );
+        __m256i vdif = subtract ? _mm256_sub_epi16( vdst, vsrc ) : _mm256_sub_epi16( vsrc, vdst );
+
+        vdif = _mm256_sra_epi16( _mm256_add_epi16( vdif, voffset256 ), vshift );
+
+        _mm256_storeu_si256( ( __m256i * )&dst[col], _mm256_add_epi16( vdst, vdif ) );
+      }
+    }
+#endif
+    for( ; col + 8 <= width; col += 8 )
+    {
+      __m128i vdst = _mm_loadu_si128( ( const __m128i * )&dst[col] );
+      __m128i vsrc = _mm_loadu_si128( ( const __m128i * )&src[col] );
+      __m128i vdif = subtract ? _mm_sub_epi16( vdst, vsrc ) : _mm_sub_epi16( vsrc, vdst );
+
+      vdif = _mm_sra_epi16( _mm_add_epi16( vdif, voffset ), vshift );
+
+      _mm_storeu_si128( ( __m128i * )&dst[col], _mm_add_epi16( vdst, vdif ) );
+    }
+
+    if( col + 4 <= width )
+    {
+      __m128i vdst = _mm_loadl_epi64( ( const __m128i * )&dst[col] );
+      __m128i vsrc = _mm_loadl_epi64( ( const __m128i * )&src[col] );
+      __m128i vdif = subtract ? _mm_sub_epi16( vdst, vsrc ) : _mm_sub_epi16( vsrc, vdst );
+
+      vdif = _mm_sra_epi16( _mm_add_epi16( vdif, voffset ), vshift );
+
+      _mm_storel_epi64( ( __m128i * )&dst[col], _mm_add_epi16( vdst, vdif ) );
+      col += 4;
+    }
+
+    for( ; col < width; col++ )
+    {
+      dst[col] += subtract ? ( dst[col] - src[col] + offset ) >> shift : ( src[col] - dst[col] + offset ) >> shift;
+    }
+
+    dst += dstStride;
+    src += srcStride;
+  }
+}
+
+template< X86_VEXT vext >
+Void obmcBlendVer_SSE( Pel *dst, Int dstStride, const Pel* src, Int srcStride, Int height, Int numLines, Int lineStep, bool subtract )
+{
+  Int row = 0;
+
+  if( numLines == 4 )
+  {
+    // four lines of a row fit into 64 bit, the per-lane arithmetic shift by 2..5 is done as a high multiplication by 2^(16-shift)
+    const Int     base    = lineStep < 0 ? -3 : 0;
+    const __m128i voffset = lineStep < 0 ? _mm_setr_epi16( 16, 8, 4, 2, 16, 8, 4, 2 )                                     : _mm_setr_epi16( 2, 4, 8, 16, 2, 4, 8, 16 );
+    const __m128i vscale  = lineStep < 0 ? _mm_setr_epi16( 1 << 11, 1 << 12, 1 << 13, 1 << 14, 1 << 11, 1 << 12, 1 << 13, 1 << 14 ) : _mm_setr_epi16( 1 << 14, 1 << 13, 1 << 12, 1 << 11, 1 << 14, 1 << 13, 1 << 12, 1 << 11 );
+
+    for( ; row + 2 <= height; row += 2 )
+    {
+      Pel       *dst0 = dst + base;
+      const Pel *src0 = src + base;
+
+      __m128i vdst = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i * )dst0 ), _mm_loadl_epi64( ( const __m128i * )&dst0[dstStride] ) );
+      __m128i vsrc = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i * )src0 ), _mm_loadl_epi64( ( const __m128i * )&src0[srcStride] ) );
+      __m128i vdif = subtract ? _mm_sub_epi16( vdst, vsrc ) : _mm_sub_epi16( vsrc, vdst );
+
+      vdif = _mm_mulhi_epi16( _mm_add_epi16( vdif, voffset ), vscale );
+      vdst = _mm_add_epi16  ( vdst, vdif );
+
+      _mm_storel_epi64( ( __m128i * )dst0,               vdst );
+      _mm_storel_epi64( ( __m128i * )&dst0[dstStride], _mm_unpackhi_epi64( vdst, vdst ) );
+
+      dst += 2 * dstStride;
+      src += 2 * srcStride;
+    }
+  }
+
+  for( ; row < height; row++ )
+  {
+    for( Int line = 0; line < numLines; line++ )
+    {
+      const Int shift  = line + 2;
+      const Int offset = 1 << ( line + 1 );
+      const Int pos    = line * lineStep;
+
+      dst[pos] += subtract ? ( dst[pos] - src[pos] + offset ) >> shift : ( src[pos] - dst[pos] + offset ) >> shift;
+    }
+
+    dst += dstStride;
+    src += srcStride;
+  }
+}
+
+template< X86_VEXT vext >
+Void licSums_SSE( const Pel* ref, const Pel* rec, Int num, Int* sums )
+{
+  // the template samples have at most 12 bit, so the pairwise products of madd cannot overflow
+  __m128i vone = _mm_set1_epi16( 1 );
+  __m128i vx   = _mm_setzero_si128();
+  __m128i vy   = _mm_setzero_si128();
+  __m128i vxx  = _mm_setzero_si128();
+  __m128i vxy  = _mm_setzero_si128();
+  Int     k    = 0;
+
+#if USE_AVX2
+  if( vext >= AVX2 && num >= 16 )
+  {
+    __m256i vone256 = _mm256_set1_epi16( 1 );
+    __m256i vx256   = _mm256_setzero_si256();
+    __m256i vy256   = _mm256_setzero_si256();
+    __m256i vxx256  = _mm256_setzero_si256();
+    __m256i vxy256  = _mm256_setzero_si256();
+
+    for( ; k + 16 <= num; k += 16 )
+    {
+      __m256i vref = _mm256_loadu_si256( ( const __m256i * )&ref[k] );
+      __m256i vrec = _mm256_loadu_si256( ( const __m256i * )&rec[k] );
+
+      vx256  = _mm256_add_epi32( vx256,  _mm256_madd_epi16( vref, vone256 ) );
+      vy256  = _mm256_add_epi32( vy256,  _mm256_madd_epi16( vrec, vone256 ) );
+      vxx256 = _mm256_add_epi32( vxx256, _mm256_madd_epi16( vref, vref ) );
+      vxy256 = _mm256_add_epi32( vxy256, _mm256_madd_epi16( vref, vrec ) );
+    }
+
+    vx  = _mm_add_epi32( _mm256_castsi256_si128( vx256 ),  _mm256_extracti128_si256( vx256,  1 ) );
+    vy  = _mm_add_epi32( _mm256_castsi256_si128( vy256 ),  _mm256_extracti128_si256( vy256,  1 ) );
+    vxx = _mm_add_epi32( _mm256_castsi256_si128( vxx256 ), _mm256_extracti128_si256( vxx256, 1 ) );
+    vxy = _mm_add_epi32( _mm256_castsi256_si128( vxy256 ), _mm256_extracti128_si256( vxy256, 1 ) );
+  }
+#endif
+  for( ; k + 8 <= num; k += 8 )
+  {
+    __m128i vref = _mm_loadu_si128( ( const __m128i * )&ref[k] );
+    __m128i vrec = _mm_loadu_si128( ( const __m128i * )&rec[k] );
+
+    vx  = _mm_add_epi32( vx,  _mm_madd_epi16( vref, vone ) );
+    vy  = _mm_add_epi32( vy,  _mm_madd_epi16( vrec, vone ) );
+    vxx = _mm_add_epi32( vxx, _mm_madd_epi16( vref, vref ) );
+    vxy = _mm_add_epi32( vxy, _mm_madd_epi16( vref, vrec ) );
+  }
+
+  // transpose-free reduction: the four accumulators end up in the four lanes
+  __m128i vsum = _mm_hadd_epi32( _mm_hadd_epi32( vx, vy ), _mm_hadd_epi32( vxx, vxy ) );
+  _mm_storeu_si128( ( __m128i * )sums, vsum );
+
+  for( ; k < num; k++ )
+  {
+    sums[0] += ref[k];
+    sums[1] += rec[k];
+    sums[2] += ref[k] * ref[k];
+    sums[3] += ref[k] * rec[k];
+  }
+}
+
+template< X86_VEXT vext >
+Void licApply_SSE( Pel *dst, Int dstStride, Int width, Int height, Int scale, Int shift, Int offset, bool biPred, const ClpRng& clpRng )
+{
+  const Int biShift  = biPred ? IF_INTERNAL_PREC - clpRng.bd : 0;
+  const Int biOffset = biPred ? -IF_INTERNAL_OFFS : 0;
+
+  if( ( width & 3 ) != 0 || shift < 0 || biShift < 0 )
+  {
+    for( Int y = 0; y < height; y++ )
+    {
+      for( Int x = 0; x < width; x++ )
+      {
+        dst[x] = ( Pel ) ( rightShift( ClipPel( rightShift( scale * dst[x], shift ) + offset, clpRng ), -biShift ) + biOffset );
+      }
+      dst += dstStride;
+    }
+    return;
+  }
+
+  // one pass instead of the LIC transform followed by the shift to the bi-prediction format
+  const __m128i vscale    = _mm_set1_epi32( scale );
+  const __m128i voffset   = _mm_set1_epi32( offset );
+  const __m128i vbdmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vbdmax    = _mm_set1_epi16( clpRng.max );
+  const __m128i vbiShift  = _mm_cvtsi32_si128( biShift );
+  const __m128i vbiOffset = _mm_set1_epi16( biOffset );
+
+#if USE_AVX2
+  if( vext >= AVX2 && ( width & 7 ) == 0 )
+  {
+    const __m256i vscale256  = _mm256_set1_epi32( scale );
+    const __m256i voffset256 = _mm256_set1_epi32( offset );
+
+    for( Int y = 0; y < height; y++ )
+    {
+      for( Int x = 0; x < width; x += 8 )
+      {
+        __m256i val = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i * )&dst[x] ) );
+        val = _mm256_add_epi32( _mm256_srai_epi32( _mm256_mullo_epi32( val, vscale256 ), shift ), voffset256 );
+        val = _mm256_packs_epi32( val, val );
+
+        __m128i vres = _mm256_castsi256_si128( _mm256_permute4x64_epi64( val, ( 0 << 0 ) + ( 2 << 2 ) ) );
+        vres = _mm_min_epi16( vbdmax, _mm_max_epi16( vbdmin, vres ) );
+        vres = _mm_add_epi16( _mm_sll_epi16( vres, vbiShift ), vbiOffset );
+
+        _mm_storeu_si128( ( __m128i * )&dst[x], vres );
+      }
+      dst += dstStride;
+    }
+    return;
+  }
+#endif
+
+  for( Int y = 0; y < height; y++ )
+  {
+    for( Int x = 0; x < width; x += 4 )
+    {
+      __m128i val = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i * )&dst[x] ) );
+      val = _mm_add_epi32( _mm_srai_epi32( _mm_mullo_epi32( val, vscale ), shift ), voffset );
+      val = _mm_packs_epi32( val, val );
+      val = _mm_min_epi16( vbdmax, _mm_max_epi16( vbdmin, val ) );
+      val = _mm_add_epi16( _mm_sll_epi16( val, vbiShift ), vbiOffset );
+
+      _mm_storel_epi64( ( __m128i * )&dst[x], val );
+    }
+    dst += dstStride;
+  }
+}
+
+
+template< X86_VEXT vext >
+Void alfAccStats_SSE( const Int* e, Int len, Int stride, Int yLocal, Int64* E, Int64* y )
+{
+  // the 32 bit products of the sample sums cannot overflow, they are widened before the accumulation
+  // each row of E starts at the aligned group of 8 containing the diagonal, the padding of e makes the products beyond len zero
+#if USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( Int k = 0; k < len; k++ )
+    {
+      const __m256i vek = _mm256_set1_epi32( e[k] );
+
+      for( Int l = k & ~7; l < len; l += 8 )
+      {
+        const __m256i vprod = _mm256_mullo_epi32( vek, _mm256_loadu_si256( ( const __m256i * )&e[l] ) );
+        const __m256i vlo   = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i * )&E[l]     ), _mm256_cvtepi32_epi64( _mm256_castsi256_si128( vprod ) ) );
+        const __m256i vhi   = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i * )&E[l + 4] ), _mm256_cvtepi32_epi64( _mm256_extracti128_si256( vprod, 1 ) ) );
+
+        _mm256_storeu_si256( ( __m256i * )&E[l],     vlo );
+        _mm256_storeu_si256( ( __m256i * )&E[l + 4], vhi );
+      }
+
+      E += stride;
+    }
+
+    const __m256i vy = _mm256_set1_epi32( yLocal );
+
+    for( Int k = 0; k < len; k += 8 )
+    {
+      const __m256i vprod = _mm256_mullo_epi32( vy, _mm256_loadu_si256( ( const __m256i * )&e[k] ) );
+      const __m256i vlo   = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i * )&y[k]     ), _mm256_cvtepi32_epi64( _mm256_castsi256_si128( vprod ) ) );
+      const __m256i vhi   = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i * )&y[k + 4] ), _mm256_cvtepi32_epi64( _mm256_extracti128_si256( vprod, 1 ) ) );
+
+      _mm256_storeu_si256( ( __m256i * )&y[k],     vlo );
+      _mm256_storeu_si256( ( __m256i * )&y[k + 4], vhi );
+    }
+    return;
+  }
+#endif
+
+  for( Int k = 0; k < len; k++ )
+  {
+    const __m128i vek = _mm_set1_epi32( e[k] );
+
+    for( Int l = k & ~3; l < len; l += 4 )
+    {
+      const __m128i vprod = _mm_mullo_epi32( vek, _mm_loadu_si128( ( const __m128i * )&e[l] ) );
+      const __m128i vlo   = _mm_add_epi64( _mm_loadu_si128( ( const __m128i * )&E[l]     ), _mm_cvtepi32_epi64( vprod ) );
+      const __m128i vhi   = _mm_add_epi64( _mm_loadu_si128( ( const __m128i * )&E[l + 2] ), _mm_cvtepi32_epi64( _mm_unpackhi_epi64( vprod, vprod ) ) );
+
+      _mm_storeu_si128( ( __m128i * )&E[l],     vlo );
+      _mm_storeu_si128( ( __m128i * )&E[l + 2], vhi );
+    }
+
+    E += stride;
+  }
+
+  const __m128i vy = _mm_set1_epi32( yLocal );
+
+  for( Int k = 0; k < len; k += 4 )
+  {
+    const __m128i vprod = _mm_mullo_epi32( vy, _mm_loadu_si128( ( const __m128i * )&e[k] ) );
+    const __m128i vlo   = _mm_add_epi64( _mm_loadu_si128( ( const __m128i * )&y[k]     ), _mm_cvtepi32_epi64( vprod ) );
+    const __m128i vhi   = _mm_add_epi64( _mm_loadu_si128( ( const __m128i * )&y[k + 2] ), _mm_cvtepi32_epi64( _mm_unpackhi_epi64( vprod, vprod ) ) );
+
+    _mm_storeu_si128( ( __m128i * )&y[k],     vlo );
+    _mm_storeu_si128( ( __m128i * )&y[k + 2], vhi );
+  }
+}
+
+#endif
+template< X86_VEXT vext >
+Void saoEdgeStats_SSE( const Pel* src, Int srcStride, const Pel* org, Int orgStride, Int width, Int height, Int offA, Int offB, Int64* diff, Int64* count )
+{
+  // the classes -2, -1, 1 and 2 are masked out, class 0 gets the remainder of the totals
+  // the 32 bit accumulators cannot overflow for blocks of up to MAX_CU_SIZE x MAX_CU_SIZE samples
+  const __m128i vone   = _mm_set1_epi16( 1 );
+  __m128i       vdiff [5];
+  __m128i       vcount[5];
+  Int           numVec = 0;
+
+  for( Int k = 0; k < 5; k++ )
+  {
+    vdiff [k] = _mm_setzero_si128();
+    vcount[k] = _mm_setzero_si128();
+  }
+
+#if USE_AVX2
+  const __m256i vone256 = _mm256_set1_epi16( 1 );
+  __m256i       vdiff256 [5];
+  __m256i       vcount256[5];
+
+  for( Int k = 0; k < 5; k++ )
+  {
+    vdiff256 [k] = _mm256_setzero_si256();
+    vcount256[k] = _mm256_setzero_si256();
+  }
+#endif
+
+  for( Int y = 0; y < height; y++ )
+  {
+    Int x = 0;
+#if USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vs = _mm256_loadu_si256( ( const __m256i * )&src[x] );
+        const __m256i va = _mm256_loadu_si256( ( const __m256i * )&src[x + offA] );
+        const __m256i vb = _mm256_loadu_si256( ( const __m256i * )&src[x + offB] );
+        const __m256i vd = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i * )&org[x] ), vs );
+
+        // sgn( s - a ) = ( a < s ) - ( s < a ), with the compare masks being -1 for true
+        const __m256i ve = _mm256_add_epi16( _mm256_sub_epi16( _mm256_cmpgt_epi16( va, vs ), _mm256_cmpgt_epi16( vs, va ) ),
+                                             _mm256_sub_epi16( _mm256_cmpgt_epi16( vb, vs ), _mm256_cmpgt_epi16( vs, vb ) ) );
+
+        vdiff256[2] = _mm256_add_epi32( vdiff256[2], _mm256_madd_epi16( vd, vone256 ) );
+
+        for( Int k = 0; k < 5; k++ )
+        {
+          if( k == 2 ) continue;
+          const __m256i vm = _mm256_cmpeq_epi16( ve, _mm256_set1_epi16( k - 2 ) );
+          vdiff256 [k] = _mm256_add_epi32( vdiff256 [k], _mm256_madd_epi16( _mm256_and_si256( vm, vd ), vone256 ) );
+          vcount256[k] = _mm256_sub_epi32( vcount256[k], _mm256_madd_epi16( vm, vone256 ) );
+        }
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vs = _mm_loadu_si128( ( const __m128i * )&src[x] );
+      const __m128i va = _mm_loadu_si128( ( const __m128i * )&src[x + offA] );
+      const __m128i vb = _mm_loadu_si128( ( const __m128i * )&src[x + offB] );
+      const __m128i vd = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i * )&org[x] ), vs );
+
+      const __m128i ve = _mm_add_epi16( _mm_sub_epi16( _mm_cmpgt_epi16( va, vs ), _mm_cmpgt_epi16( vs, va ) ),
+                                        _mm_sub_epi16( _mm_cmpgt_epi16( vb, vs ), _mm_cmpgt_epi16( vs, vb ) ) );
+
+      vdiff[2] = _mm_add_epi32( vdiff[2], _mm_madd_epi16( vd, vone ) );
+
+      for( Int k = 0; k < 5; k++ )
+      {
+        if( k == 2 ) continue;
+        const __m128i vm = _mm_cmpeq_epi16( ve, _mm_set1_epi16( k - 2 ) );
+        vdiff [k] = _mm_add_epi32( vdiff [k], _mm_madd_epi16( _mm_and_si128( vm, vd ), vone ) );
+        vcount[k] = _mm_sub_epi32( vcount[k], _mm_madd_epi16( vm, vone ) );
+      }
+    }
+    numVec += x;
+
+    for( ; x < width; x++ )
+    {
+      const Int diffA    = src[x] - src[x + offA];
+      const Int diffB    = src[x] - src[x + offB];
+      const Int edgeType = ( diffA > 0 ) - ( diffA < 0 ) + ( diffB > 0 ) - ( diffB < 0 );
+
+      diff [edgeType] += org[x] - src[x];
+      count[edgeType] ++;
+    }
+
+    src += srcStride;
+    org += orgStride;
+  }
+
+#if USE_AVX2
+  for( Int k = 0; k < 5; k++ )
+  {
+    vdiff [k] = _mm_add_epi32( vdiff [k], _mm_add_epi32( _mm256_castsi256_si128( vdiff256 [k] ), _mm256_extracti128_si256( vdiff256 [k], 1 ) ) );
+    vcount[k] = _mm_add_epi32( vcount[k], _mm_add_epi32( _mm256_castsi256_si128( vcount256[k] ), _mm256_extracti128_si256( vcount256[k], 1 ) ) );
+  }
+#endif
+
+  // the lanes of vsum hold the totals of the classes -2, -1, 0 and 1, where class 0 is the sum over all classes
+  const __m128i vsumDiff  = _mm_hadd_epi32( _mm_hadd_epi32( vdiff [0], vdiff [1] ), _mm_hadd_epi32( vdiff [2], vdiff [3] ) );
+  const __m128i vsumCount = _mm_hadd_epi32( _mm_hadd_epi32( vcount[0], vcount[1] ), _mm_hadd_epi32( vcount[2], vcount[3] ) );
+  const __m128i vlast     = _mm_hadd_epi32( _mm_hadd_epi32( vdiff [4], vcount[4] ), vone );
+
+  Int sumDiff [5] = { _mm_extract_epi32( vsumDiff,  0 ), _mm_extract_epi32( vsumDiff,  1 ), _mm_extract_epi32( vsumDiff,  2 ), _mm_extract_epi32( vsumDiff,  3 ), _mm_extract_epi32( vlast,     0 ) };
+  Int sumCount[5] = { _mm_extract_epi32( vsumCount, 0 ), _mm_extract_epi32( vsumCount, 1 ), numVec,                           _mm_extract_epi32( vsumCount, 3 ), _mm_extract_epi32( vlast,     1 ) };
+
+  for( Int k = 0; k < 5; k++ )
+  {
+    if( k == 2 ) continue;
+    sumDiff [2] -= sumDiff [k];
+    sumCount[2] -= sumCount[k];
+  }
+
+  for( Int k = 0; k < 5; k++ )
+  {
+    diff [k - 2] += sumDiff [k];
+    count[k - 2] += sumCount[k];
+  }
+}
+
+template< X86_VEXT vext >
+UInt64 calcSSE_SSE( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, Int width, Int height )
+{
+  // non-negative 16 bit samples differ by less than 2^15, so each madd pair fits into 32 bits
+  // and only the accumulation has to be widened to 64 bits
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i       vsum  = vzero;
+  UInt64        sum   = 0;
+
+#if USE_AVX2
+  const __m256i vzero256 = _mm256_setzero_si256();
+  __m256i       vsum256  = vzero256;
+#endif
+
+  for( Int y = 0; y < height; y++ )
+  {
+    Int x = 0;
+#if USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i vd  = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i * )&src0[x] ), _mm256_loadu_si256( ( const __m256i * )&src1[x] ) );
+        const __m256i vsq = _mm256_madd_epi16( vd, vd );
+
+        vsum256 = _mm256_add_epi64( vsum256, _mm256_add_epi64( _mm256_unpacklo_epi32( vsq, vzero256 ), _mm256_unpackhi_epi32( vsq, vzero256 ) ) );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i vd  = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i * )&src0[x] ), _mm_loadu_si128( ( const __m128i * )&src1[x] ) );
+      const __m128i vsq = _mm_madd_epi16( vd, vd );
+
+      vsum = _mm_add_epi64( vsum, _mm_add_epi64( _mm_unpacklo_epi32( vsq, vzero ), _mm_unpackhi_epi32( vsq, vzero ) ) );
+    }
+
+    for( ; x < width; x++ )
+    {
+      const Int diff = src0[x] - src1[x];
+      sum += UInt64( diff * diff );
+    }
+
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+#if USE_AVX2
+  vsum = _mm_add_epi64( vsum, _mm_add_epi64( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) ) );
+#endif
+  vsum = _mm_add_epi64( vsum, _mm_unpackhi_epi64( vsum, vsum ) );
+
+  return sum + UInt64( _mm_cvtsi128_si64( vsum ) );
+}
+
 template<X86_VEXT vext>
 Void PelBufferOps::_initPelBufOpsX86()
 {
@@ -373,6 +865,18 @@ Void PelBufferOps::_initPelBufOpsX86()
 
   linTf8 = linTf_SSE_entry<vext, 8>;
   linTf4 = linTf_SSE_entry<vext, 4>;
+
+  saoEdgeStats = saoEdgeStats_SSE<vext>;
+  calcSSE      = calcSSE_SSE<vext>;
+#if JEM_TOOLS
+
+  obmcBlendHor = obmcBlendHor_SSE<vext>;
+  obmcBlendVer = obmcBlendVer_SSE<vext>;
+
+  licSums      = licSums_SSE<vext>;
+  licApply     = licApply_SSE<vext>;
+  alfAccStats  = alfAccStats_SSE<vext>;
+#endif
 }
 
 template Void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
@@ -43,6 +43,8 @@
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/RdCost.h"
 #include "CommonLib/Buffer.h"
+#include "CommonLib/IntraPrediction.h"
+#include "CommonLib/BilateralFilter.h"
 
 #ifdef TARGET_SIMD_X86
 
@@ -110,5 +112,41 @@ Void RdCost::initRdCostX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_CCLM
+Void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initIntraPredictionX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initIntraPredictionX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_BIF
+Void BilateralFilter::initBilateralFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initBilateralFilterX86<AVX2>();
+      break;
+    default:
+      // the kernel relies on the AVX2 gathers, older extensions keep the scalar implementation
+      break;
+  }
+}
+#endif
+
 #endif
 
@@ -1124,6 +1124,484 @@ static Void simdFilter( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel
   }
 }
 
+#if JEM_TOOLS
+// ===========================
+// Affine 4x4 luma sub-block
+// ===========================
+static inline __m128i simdFilter4x4HorRow( Pel const *src, const __m128i& vcoeff )
+{
+  // the four 8-tap sums of one row
+  __m128i vsum0 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &src[0] ), vcoeff );
+  __m128i vsum1 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &src[1] ), vcoeff );
+  __m128i vsum2 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &src[2] ), vcoeff );
+  __m128i vsum3 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &src[3] ), vcoeff );
+  return _mm_hadd_epi32( _mm_hadd_epi32( vsum0, vsum1 ), _mm_hadd_epi32( vsum2, vsum3 ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i simdFilter4x4HorRow2( Pel const *src, Int srcStride, const __m256i& vcoeff )
+{
+  // two rows at once, one per 128-bit lane
+  __m256i vsum0 = _mm256_madd_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) &src[0] ) ), _mm_loadu_si128( ( const __m128i* ) &src[srcStride + 0] ), 1 ), vcoeff );
+  __m256i vsum1 = _mm256_madd_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) &src[1] ) ), _mm_loadu_si128( ( const __m128i* ) &src[srcStride + 1] ), 1 ), vcoeff );
+  __m256i vsum2 = _mm256_madd_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) &src[2] ) ), _mm_loadu_si128( ( const __m128i* ) &src[srcStride + 2] ), 1 ), vcoeff );
+  __m256i vsum3 = _mm256_madd_epi16( _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) &src[3] ) ), _mm_loadu_si128( ( const __m128i* ) &src[srcStride + 3] ), 1 ), vcoeff );
+  return _mm256_hadd_epi32( _mm256_hadd_epi32( vsum0, vsum1 ), _mm256_hadd_epi32( vsum2, vsum3 ) );
+}
+#endif
+
+template<X86_VEXT vext, Bool isLast>
+static Void simdFilter4x4( const ClpRng& clpRng, Pel const *src, Int srcStride, Pel *dst, Int dstStride, TFilterCoeff const *coeffH, TFilterCoeff const *coeffV )
+{
+  if( clpRng.bd > 10 )
+  {
+    Pel tmp[( 4 + NTAPS_LUMA - 1 ) * 4];
+    simdFilter<vext, NTAPS_LUMA, false, true, false>( clpRng, src - ( NTAPS_LUMA / 2 - 1 ) * srcStride, srcStride, tmp, 4, 4, 4 + NTAPS_LUMA - 1, coeffH );
+    simdFilter<vext, NTAPS_LUMA, true, false, isLast>( clpRng, tmp + ( NTAPS_LUMA / 2 - 1 ) * 4, 4, dst, dstStride, 4, 4, coeffV );
+    return;
+  }
+
+  // same rounding as simdFilter<vext, 8, false, true, false> followed by simdFilter<vext, 8, true, false, isLast>
+  const Int headRoom = std::max<Int>( 2, ( IF_INTERNAL_PREC - clpRng.bd ) );
+  const Int shiftH   = IF_FILTER_PREC - headRoom;
+  const Int offsetH  = -IF_INTERNAL_OFFS << shiftH;
+  const Int shiftV   = IF_FILTER_PREC + ( isLast ? headRoom : 0 );
+  const Int offsetV  = isLast ? ( 1 << ( shiftV - 1 ) ) + ( IF_INTERNAL_OFFS << IF_FILTER_PREC ) : 0;
+
+  const Int numRows  = 4 + NTAPS_LUMA - 1;
+
+  // horizontal pass, the intermediate rows are kept in the lower halves of the registers
+  __m128i vtmp[numRows];
+  const __m128i vcoeffH  = _mm_loadu_si128( ( const __m128i* ) coeffH );
+  const __m128i voffsetH = _mm_set1_epi32( offsetH );
+
+  src -= ( NTAPS_LUMA / 2 - 1 ) * srcStride + ( NTAPS_LUMA / 2 - 1 );
+
+  Int row = 0;
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vcoeffH256  = _mm256_broadcastsi128_si256( vcoeffH );
+    const __m256i voffsetH256 = _mm256_set1_epi32( offsetH );
+
+    for( ; row + 2 <= numRows; row += 2 )
+    {
+      __m256i vsum = simdFilter4x4HorRow2( src + row * srcStride, srcStride, vcoeffH256 );
+      vsum         = _mm256_srai_epi32( _mm256_add_epi32( vsum, voffsetH256 ), shiftH );
+      vsum         = _mm256_packs_epi32( vsum, vsum );
+      vtmp[row    ] = _mm256_castsi256_si128( vsum );
+      vtmp[row + 1] = _mm256_extracti128_si256( vsum, 1 );
+    }
+  }
+#endif
+  for( ; row < numRows; row++ )
+  {
+    __m128i vsum = simdFilter4x4HorRow( src + row * srcStride, vcoeffH );
+    vsum         = _mm_srai_epi32( _mm_add_epi32( vsum, voffsetH ), shiftH );
+    vtmp[row]    = _mm_packs_epi32( vsum, vsum );
+  }
+
+  // vertical pass on interleaved pairs of intermediate rows
+  __m128i vpair[numRows - 1];
+  for( Int i = 0; i < numRows - 1; i++ )
+  {
+    vpair[i] = _mm_unpacklo_epi16( vtmp[i], vtmp[i + 1] );
+  }
+
+  __m128i vcoeffV[NTAPS_LUMA / 2];
+  for( Int i = 0; i < NTAPS_LUMA; i += 2 )
+  {
+    vcoeffV[i / 2] = _mm_unpacklo_epi16( _mm_set1_epi16( coeffV[i] ), _mm_set1_epi16( coeffV[i + 1] ) );
+  }
+
+  const __m128i voffsetV = _mm_set1_epi32( offsetV );
+  const __m128i vibdimin = _mm_set1_epi16( clpRng.min );
+  const __m128i vibdimax = _mm_set1_epi16( clpRng.max );
+
+  row = 0;
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i voffsetV256 = _mm256_set1_epi32( offsetV );
+
+    for( ; row < 4; row += 2 )
+    {
+      __m256i vsum = _mm256_setzero_si256();
+      for( Int i = 0; i < NTAPS_LUMA / 2; i++ )
+      {
+        __m256i vsrc = _mm256_inserti128_si256( _mm256_castsi128_si256( vpair[row + 2 * i] ), vpair[row + 2 * i + 1], 1 );
+        vsum         = _mm256_add_epi32( vsum, _mm256_madd_epi16( vsrc, _mm256_broadcastsi128_si256( vcoeffV[i] ) ) );
+      }
+      vsum = _mm256_srai_epi32( _mm256_add_epi32( vsum, voffsetV256 ), shiftV );
+      vsum = _mm256_packs_epi32( vsum, vsum );
+
+      __m128i vres0 = _mm256_castsi256_si128( vsum );
+      __m128i vres1 = _mm256_extracti128_si256( vsum, 1 );
+      if( isLast )
+      {
+        vres0 = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vres0 ) );
+        vres1 = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vres1 ) );
+      }
+      _mm_storel_epi64( ( __m128i* ) &dst[ row      * dstStride], vres0 );
+      _mm_storel_epi64( ( __m128i* ) &dst[( row + 1 ) * dstStride], vres1 );
+    }
+  }
+#endif
+  for( ; row < 4; row++ )
+  {
+    __m128i vsum = _mm_setzero_si128();
+    for( Int i = 0; i < NTAPS_LUMA / 2; i++ )
+    {
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( vpair[row + 2 * i], vcoeffV[i] ) );
+    }
+    vsum = _mm_srai_epi32( _mm_add_epi32( vsum, voffsetV ), shiftV );
+    vsum = _mm_packs_epi32( vsum, vsum );
+    if( isLast )
+    {
+      vsum = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vsum ) );
+    }
+    _mm_storel_epi64( ( __m128i* ) &dst[row * dstStride], vsum );
+  }
+}
+#endif
+
+#if JEM_TOOLS
+// ===========================
+// BIO
+// ===========================
+static inline __m128i simdBioRound( __m128i vsum, __m128i voffset, __m128i vshift )
+{
+  // the offset is applied to the magnitude, the result is truncated to 16 bit like the ( Pel ) cast in the scalar code
+  __m128i vsign = _mm_srai_epi32( vsum, 31 );
+  __m128i vres  = _mm_sra_epi32( _mm_add_epi32( _mm_abs_epi32( vsum ), voffset ), vshift );
+  vres          = _mm_sub_epi32( _mm_xor_si128( vres, vsign ), vsign );
+  return _mm_srai_epi32( _mm_slli_epi32( vres, 16 ), 16 );
+}
+
+#ifdef USE_AVX2
+static inline __m256i simdBioRound( __m256i vsum, __m256i voffset, __m128i vshift )
+{
+  __m256i vsign = _mm256_srai_epi32( vsum, 31 );
+  __m256i vres  = _mm256_sra_epi32( _mm256_add_epi32( _mm256_abs_epi32( vsum ), voffset ), vshift );
+  vres          = _mm256_sub_epi32( _mm256_xor_si256( vres, vsign ), vsign );
+  return _mm256_srai_epi32( _mm256_slli_epi32( vres, 16 ), 16 );
+}
+#endif
+
+template<X86_VEXT vext, Bool isVertical>
+static Void simdFilterBio( Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Short const *coeff, Int shift, Int offset )
+{
+  const Int cStride = isVertical ? srcStride : 1;
+  src -= BIO_FILTER_HALF_LENGTH_MINUS_1 * cStride;
+
+  // the taps are applied pairwise with madd on interleaved samples
+  const __m128i vcoeff01 = _mm_unpacklo_epi16( _mm_set1_epi16( coeff[0] ), _mm_set1_epi16( coeff[1] ) );
+  const __m128i vcoeff23 = _mm_unpacklo_epi16( _mm_set1_epi16( coeff[2] ), _mm_set1_epi16( coeff[3] ) );
+  const __m128i vcoeff45 = _mm_unpacklo_epi16( _mm_set1_epi16( coeff[4] ), _mm_set1_epi16( coeff[5] ) );
+  const __m128i voffset  = _mm_set1_epi32( offset );
+  const __m128i vshift   = _mm_cvtsi32_si128( shift );
+#ifdef USE_AVX2
+  const __m256i vcoeff01_256 = _mm256_broadcastsi128_si256( vcoeff01 );
+  const __m256i vcoeff23_256 = _mm256_broadcastsi128_si256( vcoeff23 );
+  const __m256i vcoeff45_256 = _mm256_broadcastsi128_si256( vcoeff45 );
+  const __m256i voffset256   = _mm256_set1_epi32( offset );
+#endif
+
+  for( Int row = 0; row < height; row++ )
+  {
+    Int col = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; col + 16 <= width; col += 16 )
+      {
+        __m256i vsrc0 = _mm256_loadu_si256( ( const __m256i* ) &src[col              ] );
+        __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i* ) &src[col +     cStride] );
+        __m256i vsrc2 = _mm256_loadu_si256( ( const __m256i* ) &src[col + 2 * cStride] );
+        __m256i vsrc3 = _mm256_loadu_si256( ( const __m256i* ) &src[col + 3 * cStride] );
+        __m256i vsrc4 = _mm256_loadu_si256( ( const __m256i* ) &src[col + 4 * cStride] );
+        __m256i vsrc5 = _mm256_loadu_si256( ( const __m256i* ) &src[col + 5 * cStride] );
+
+        __m256i vsumLo = _mm256_madd_epi16( _mm256_unpacklo_epi16( vsrc0, vsrc1 ), vcoeff01_256 );
+        __m256i vsumHi = _mm256_madd_epi16( _mm256_unpackhi_epi16( vsrc0, vsrc1 ), vcoeff01_256 );
+        vsumLo = _mm256_add_epi32( vsumLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vsrc2, vsrc3 ), vcoeff23_256 ) );
+        vsumHi = _mm256_add_epi32( vsumHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vsrc2, vsrc3 ), vcoeff23_256 ) );
+        vsumLo = _mm256_add_epi32( vsumLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vsrc4, vsrc5 ), vcoeff45_256 ) );
+        vsumHi = _mm256_add_epi32( vsumHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vsrc4, vsrc5 ), vcoeff45_256 ) );
+
+        vsumLo = simdBioRound( vsumLo, voffset256, vshift );
+        vsumHi = simdBioRound( vsumHi, voffset256, vshift );
+
+        _mm256_storeu_si256( ( __m256i* ) &dst[col], _mm256_packs_epi32( vsumLo, vsumHi ) );
+      }
+    }
+#endif
+
+    for( ; col + 8 <= width; col += 8 )
+    {
+      __m128i vsrc0 = _mm_loadu_si128( ( const __m128i* ) &src[col              ] );
+      __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* ) &src[col +     cStride] );
+      __m128i vsrc2 = _mm_loadu_si128( ( const __m128i* ) &src[col + 2 * cStride] );
+      __m128i vsrc3 = _mm_loadu_si128( ( const __m128i* ) &src[col + 3 * cStride] );
+      __m128i vsrc4 = _mm_loadu_si128( ( const __m128i* ) &src[col + 4 * cStride] );
+      __m128i vsrc5 = _mm_loadu_si128( ( const __m128i* ) &src[col + 5 * cStride] );
+
+      __m128i vsumLo = _mm_madd_epi16( _mm_unpacklo_epi16( vsrc0, vsrc1 ), vcoeff01 );
+      __m128i vsumHi = _mm_madd_epi16( _mm_unpackhi_epi16( vsrc0, vsrc1 ), vcoeff01 );
+      vsumLo = _mm_add_epi32( vsumLo, _mm_madd_epi16( _mm_unpacklo_epi16( vsrc2, vsrc3 ), vcoeff23 ) );
+      vsumHi = _mm_add_epi32( vsumHi, _mm_madd_epi16( _mm_unpackhi_epi16( vsrc2, vsrc3 ), vcoeff23 ) );
+      vsumLo = _mm_add_epi32( vsumLo, _mm_madd_epi16( _mm_unpacklo_epi16( vsrc4, vsrc5 ), vcoeff45 ) );
+      vsumHi = _mm_add_epi32( vsumHi, _mm_madd_epi16( _mm_unpackhi_epi16( vsrc4, vsrc5 ), vcoeff45 ) );
+
+      vsumLo = simdBioRound( vsumLo, voffset, vshift );
+      vsumHi = simdBioRound( vsumHi, voffset, vshift );
+
+      _mm_storeu_si128( ( __m128i* ) &dst[col], _mm_packs_epi32( vsumLo, vsumHi ) );
+    }
+
+    for( ; col + 4 <= width; col += 4 )
+    {
+      __m128i vsrc0 = _mm_loadl_epi64( ( const __m128i* ) &src[col              ] );
+      __m128i vsrc1 = _mm_loadl_epi64( ( const __m128i* ) &src[col +     cStride] );
+      __m128i vsrc2 = _mm_loadl_epi64( ( const __m128i* ) &src[col + 2 * cStride] );
+      __m128i vsrc3 = _mm_loadl_epi64( ( const __m128i* ) &src[col + 3 * cStride] );
+      __m128i vsrc4 = _mm_loadl_epi64( ( const __m128i* ) &src[col + 4 * cStride] );
+      __m128i vsrc5 = _mm_loadl_epi64( ( const __m128i* ) &src[col + 5 * cStride] );
+
+      __m128i vsum = _mm_madd_epi16( _mm_unpacklo_epi16( vsrc0, vsrc1 ), vcoeff01 );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_unpacklo_epi16( vsrc2, vsrc3 ), vcoeff23 ) );
+      vsum = _mm_add_epi32( vsum, _mm_madd_epi16( _mm_unpacklo_epi16( vsrc4, vsrc5 ), vcoeff45 ) );
+      vsum = simdBioRound( vsum, voffset, vshift );
+
+      _mm_storel_epi64( ( __m128i* ) &dst[col], _mm_packs_epi32( vsum, vsum ) );
+    }
+
+    for( ; col < width; col++ )
+    {
+      Int sum = 0;
+
+      for( Int i = 0; i < BIO_FILTER_LENGTH; i++ )
+      {
+        sum += coeff[i] * src[col + i * cStride];
+      }
+
+      sum      = ( sum >= 0 ? ( sum + offset ) >> shift : -( ( -sum + offset ) >> shift ) );
+      dst[col] = ( Pel ) sum;
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext>
+static Void simdBioGradSums( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, Int width, Int height, Int64* const dotProducts[BIO_NUM_GRAD_SUMS], Int64* blkSums )
+{
+  // per sample products, the sample differences and gradient sums are exact in 32 bit, the products need 64 bit
+  for( Int y = 0; y < height; y++ )
+  {
+    const Int offs = y * width;
+
+    for( Int x = 0; x < width; x += 4 )
+    {
+      __m128i vt  = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &src0  [x] ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &src1  [x] ) ) );
+      __m128i vtx = _mm_add_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradX0[x] ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradX1[x] ) ) );
+      __m128i vty = _mm_add_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradY0[x] ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradY1[x] ) ) );
+
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        const __m256i vzero = _mm256_setzero_si256();
+        __m256i vt64  = _mm256_cvtepi32_epi64( vt );
+        __m256i vtx64 = _mm256_cvtepi32_epi64( vtx );
+        __m256i vty64 = _mm256_cvtepi32_epi64( vty );
+
+        _mm256_storeu_si256( ( __m256i* ) &dotProducts[0][offs + x], _mm256_mul_epi32( vtx64, vtx64 ) );
+        _mm256_storeu_si256( ( __m256i* ) &dotProducts[1][offs + x], _mm256_mul_epi32( vtx64, vty64 ) );
+        _mm256_storeu_si256( ( __m256i* ) &dotProducts[2][offs + x], _mm256_slli_epi64( _mm256_sub_epi64( vzero, _mm256_mul_epi32( vtx64, vt64 ) ), 5 ) );
+        _mm256_storeu_si256( ( __m256i* ) &dotProducts[3][offs + x], _mm256_slli_epi64( _mm256_mul_epi32( vty64, vty64 ), 1 ) );
+        _mm256_storeu_si256( ( __m256i* ) &dotProducts[4][offs + x], _mm256_slli_epi64( _mm256_sub_epi64( vzero, _mm256_mul_epi32( vty64, vt64 ) ), 6 ) );
+      }
+      else
+#endif
+      {
+        const __m128i vzero = _mm_setzero_si128();
+
+        for( Int i = 0; i < 4; i += 2 )
+        {
+          __m128i vt64  = _mm_cvtepi32_epi64( vt );
+          __m128i vtx64 = _mm_cvtepi32_epi64( vtx );
+          __m128i vty64 = _mm_cvtepi32_epi64( vty );
+
+          _mm_storeu_si128( ( __m128i* ) &dotProducts[0][offs + x + i], _mm_mul_epi32( vtx64, vtx64 ) );
+          _mm_storeu_si128( ( __m128i* ) &dotProducts[1][offs + x + i], _mm_mul_epi32( vtx64, vty64 ) );
+          _mm_storeu_si128( ( __m128i* ) &dotProducts[2][offs + x + i], _mm_slli_epi64( _mm_sub_epi64( vzero, _mm_mul_epi32( vtx64, vt64 ) ), 5 ) );
+          _mm_storeu_si128( ( __m128i* ) &dotProducts[3][offs + x + i], _mm_slli_epi64( _mm_mul_epi32( vty64, vty64 ), 1 ) );
+          _mm_storeu_si128( ( __m128i* ) &dotProducts[4][offs + x + i], _mm_slli_epi64( _mm_sub_epi64( vzero, _mm_mul_epi32( vty64, vt64 ) ), 6 ) );
+
+          vt  = _mm_srli_si128( vt,  8 );
+          vtx = _mm_srli_si128( vtx, 8 );
+          vty = _mm_srli_si128( vty, 8 );
+        }
+      }
+    }
+
+    src0   += src0Stride;
+    src1   += src1Stride;
+    gradX0 += width;
+    gradX1 += width;
+    gradY0 += width;
+    gradY1 += width;
+  }
+
+  // the ( 1, 2, 3, 4, 4, 3, 2, 1 ) window weights are separable: the vertical pass is done in SIMD over complete
+  // rows of sub-blocks, the horizontal pass per sub-block on the vertical sums; both use
+  // s1 + 2 * s2 + 3 * s3 + 4 * s4 = s1 + s3 + 2 * ( s2 + s3 + 2 * s4 ), sk being the sum of the two samples weighted by k
+  Int64 vertSums[BIO_NUM_GRAD_SUMS][MAX_CU_SIZE];
+
+  for( Int sy = 0; sy < height; sy += 4 )
+  {
+    Int rowOffs[8];
+    for( Int y = 0; y < 8; y++ )
+    {
+      rowOffs[y] = std::min( std::max( sy + y - 2, 0 ), height - 1 ) * width;
+    }
+
+    for( Int k = 0; k < BIO_NUM_GRAD_SUMS; k++ )
+    {
+      const Int64* p = dotProducts[k];
+      Int x = 0;
+
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        for( ; x < width; x += 4 )
+        {
+          __m256i vs1 = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) &p[rowOffs[0] + x] ), _mm256_loadu_si256( ( const __m256i* ) &p[rowOffs[7] + x] ) );
+          __m256i vs2 = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) &p[rowOffs[1] + x] ), _mm256_loadu_si256( ( const __m256i* ) &p[rowOffs[6] + x] ) );
+          __m256i vs3 = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) &p[rowOffs[2] + x] ), _mm256_loadu_si256( ( const __m256i* ) &p[rowOffs[5] + x] ) );
+          __m256i vs4 = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) &p[rowOffs[3] + x] ), _mm256_loadu_si256( ( const __m256i* ) &p[rowOffs[4] + x] ) );
+
+          __m256i vsum = _mm256_add_epi64( _mm256_add_epi64( vs2, vs3 ), _mm256_slli_epi64( vs4, 1 ) );
+          vsum = _mm256_add_epi64( _mm256_add_epi64( vs1, vs3 ), _mm256_slli_epi64( vsum, 1 ) );
+
+          _mm256_storeu_si256( ( __m256i* ) &vertSums[k][x], vsum );
+        }
+      }
+#endif
+
+      for( ; x < width; x += 2 )
+      {
+        __m128i vs1 = _mm_add_epi64( _mm_loadu_si128( ( const __m128i* ) &p[rowOffs[0] + x] ), _mm_loadu_si128( ( const __m128i* ) &p[rowOffs[7] + x] ) );
+        __m128i vs2 = _mm_add_epi64( _mm_loadu_si128( ( const __m128i* ) &p[rowOffs[1] + x] ), _mm_loadu_si128( ( const __m128i* ) &p[rowOffs[6] + x] ) );
+        __m128i vs3 = _mm_add_epi64( _mm_loadu_si128( ( const __m128i* ) &p[rowOffs[2] + x] ), _mm_loadu_si128( ( const __m128i* ) &p[rowOffs[5] + x] ) );
+        __m128i vs4 = _mm_add_epi64( _mm_loadu_si128( ( const __m128i* ) &p[rowOffs[3] + x] ), _mm_loadu_si128( ( const __m128i* ) &p[rowOffs[4] + x] ) );
+
+        __m128i vsum = _mm_add_epi64( _mm_add_epi64( vs2, vs3 ), _mm_slli_epi64( vs4, 1 ) );
+        vsum = _mm_add_epi64( _mm_add_epi64( vs1, vs3 ), _mm_slli_epi64( vsum, 1 ) );
+
+        _mm_storeu_si128( ( __m128i* ) &vertSums[k][x], vsum );
+      }
+    }
+
+    for( Int sx = 0; sx < width; sx += 4, blkSums += BIO_NUM_GRAD_SUMS )
+    {
+      const Int xl2 = std::max( sx - 2, 0 );
+      const Int xl1 = std::max( sx - 1, 0 );
+      const Int xr1 = std::min( sx + 4, width - 1 );
+      const Int xr2 = std::min( sx + 5, width - 1 );
+
+      for( Int k = 0; k < BIO_NUM_GRAD_SUMS; k++ )
+      {
+        const Int64* v = vertSums[k];
+
+        const Int64 s1 = v[xl2]    + v[xr2];
+        const Int64 s2 = v[xl1]    + v[xr1];
+        const Int64 s3 = v[sx]     + v[sx + 3];
+        const Int64 s4 = v[sx + 1] + v[sx + 2];
+
+        blkSums[k] = s1 + s3 + 2 * ( s2 + s3 + 2 * s4 );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static Void simdBioApply( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, const Pel* gradX0, const Pel* gradX1, const Pel* gradY0, const Pel* gradY1, Pel* dst, Int dstStride, Int width, Int height, const Int* vx, const Int* vy, Int shiftNum, Int offset, const ClpRng& clpRng )
+{
+  const __m128i vrnd    = _mm_set1_epi32( 32 );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vshift  = _mm_cvtsi32_si128( shiftNum );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  const __m256i vrnd256    = _mm256_set1_epi32( 32 );
+  const __m256i voffset256 = _mm256_set1_epi32( offset );
+#endif
+
+  for( Int y = 0; y < height; y++ )
+  {
+    const Int* blkVx = vx + ( y >> 2 ) * ( width >> 2 );
+    const Int* blkVy = vy + ( y >> 2 ) * ( width >> 2 );
+    Int x = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 8 <= width; x += 8 )
+      {
+        __m256i vvx  = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_set1_epi32( blkVx[x >> 2] ) ), _mm_set1_epi32( blkVx[( x >> 2 ) + 1] ), 1 );
+        __m256i vvy  = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_set1_epi32( blkVy[x >> 2] ) ), _mm_set1_epi32( blkVy[( x >> 2 ) + 1] ), 1 );
+        __m256i vgx  = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &gradX0[x] ) ), _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &gradX1[x] ) ) );
+        __m256i vgy  = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &gradY0[x] ) ), _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &gradY1[x] ) ) );
+        __m256i vb   = _mm256_add_epi32( _mm256_mullo_epi32( vvx, vgx ), _mm256_mullo_epi32( vvy, vgy ) );
+        __m256i vsgn = _mm256_srai_epi32( vb, 31 );
+        vb           = _mm256_srai_epi32( _mm256_add_epi32( _mm256_abs_epi32( vb ), vrnd256 ), 6 );
+        vb           = _mm256_sub_epi32( _mm256_xor_si256( vb, vsgn ), vsgn );
+
+        __m256i vsum = _mm256_add_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src0[x] ) ), _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &src1[x] ) ) );
+        vsum         = _mm256_sra_epi32( _mm256_add_epi32( vsum, _mm256_add_epi32( vb, voffset256 ) ), vshift );
+        vsum         = _mm256_srai_epi32( _mm256_slli_epi32( vsum, 16 ), 16 );
+
+        __m128i vres = _mm_packs_epi32( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+        vres         = _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[x], vres );
+      }
+    }
+#endif
+
+    for( ; x < width; x += 4 )
+    {
+      __m128i vvx  = _mm_set1_epi32( blkVx[x >> 2] );
+      __m128i vvy  = _mm_set1_epi32( blkVy[x >> 2] );
+      __m128i vgx  = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradX0[x] ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradX1[x] ) ) );
+      __m128i vgy  = _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradY0[x] ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &gradY1[x] ) ) );
+      __m128i vb   = _mm_add_epi32( _mm_mullo_epi32( vvx, vgx ), _mm_mullo_epi32( vvy, vgy ) );
+      __m128i vsgn = _mm_srai_epi32( vb, 31 );
+      vb           = _mm_srai_epi32( _mm_add_epi32( _mm_abs_epi32( vb ), vrnd ), 6 );
+      vb           = _mm_sub_epi32( _mm_xor_si128( vb, vsgn ), vsgn );
+
+      __m128i vsum = _mm_add_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &src0[x] ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &src1[x] ) ) );
+      vsum         = _mm_sra_epi32( _mm_add_epi32( vsum, _mm_add_epi32( vb, voffset ) ), vshift );
+      vsum         = _mm_srai_epi32( _mm_slli_epi32( vsum, 16 ), 16 );
+
+      __m128i vres = _mm_packs_epi32( vsum, vsum );
+      vres         = _mm_min_epi16( vmax, _mm_max_epi16( vmin, vres ) );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], vres );
+    }
+
+    src0   += src0Stride;
+    src1   += src1Stride;
+    gradX0 += width;
+    gradX1 += width;
+    gradY0 += width;
+    gradY1 += width;
+    dst    += dstStride;
+  }
+}
+#endif
+
 template <X86_VEXT vext>
 Void InterpolationFilter::_initInterpolationFilterX86()
 {
@@ -1162,6 +1640,15 @@ Void InterpolationFilter::_initInterpolationFilterX86()
   m_filterCopy[0][1]   = simdFilterCopy<vext, false, true>;
   m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
   m_filterCopy[1][1]   = simdFilterCopy<vext, true, true>;
+
+#if JEM_TOOLS
+  m_filter4x4[0]       = simdFilter4x4<vext, false>;
+  m_filter4x4[1]       = simdFilter4x4<vext, true>;
+  m_filterBio[0]       = simdFilterBio<vext, false>;
+  m_filterBio[1]       = simdFilterBio<vext, true>;
+  m_bioGradSums        = simdBioGradSums<vext>;
+  m_bioApply           = simdBioApply<vext>;
+#endif
 }
 
 template Void InterpolationFilter::_initInterpolationFilterX86<SIMDX86>();
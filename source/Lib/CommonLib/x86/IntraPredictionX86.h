@@ -0,0 +1,349 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredictionX86.h
+    \brief    SIMD for the cross-component linear model prediction
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/IntraPrediction.h"
+
+#if ENABLE_SIMD_OPT_CCLM
+#ifdef TARGET_SIMD_X86
+
+template< X86_VEXT vext >
+Void lumaDownsample_SSE( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, Bool leftAvailable )
+{
+  // pairs of ( 2, 1 ) weights the even (center) and odd (right) sample of each 2x1 luma group,
+  // the odd (left) sample of the preceding group is carried over from the previous iteration
+  const __m128i vcoeff  = _mm_set1_epi32( ( 1 << 16 ) | 2 );
+  const __m128i voffset = _mm_set1_epi32( 4 );
+#ifdef USE_AVX2
+  const __m256i vcoeff256  = _mm256_set1_epi32( ( 1 << 16 ) | 2 );
+  const __m256i voffset256 = _mm256_set1_epi32( 4 );
+#endif
+
+  for( Int j = 0; j < height; j++ )
+  {
+    Int carry = leftAvailable ? src[-1] + src[srcStride - 1] : 0;
+    Int i     = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; i + 8 <= width; i += 8 )
+      {
+        __m256i vrow0 = _mm256_loadu_si256( ( const __m256i* ) &src[2 * i] );
+        __m256i vrow1 = _mm256_loadu_si256( ( const __m256i* ) &src[2 * i + srcStride] );
+
+        __m256i vsum  = _mm256_add_epi32( _mm256_madd_epi16( vrow0, vcoeff256 ), _mm256_madd_epi16( vrow1, vcoeff256 ) );
+        __m256i vodd  = _mm256_add_epi32( _mm256_srli_epi32( vrow0, 16 ), _mm256_srli_epi32( vrow1, 16 ) );
+        __m256i vprev = _mm256_alignr_epi8( vodd, _mm256_permute2x128_si256( vodd, vodd, 0x08 ), 12 );
+        vprev         = _mm256_blend_epi32( vprev, _mm256_set1_epi32( carry ), 0x01 );
+        carry         = _mm256_extract_epi32( vodd, 7 );
+
+        vsum = _mm256_add_epi32( vsum, _mm256_add_epi32( vprev, voffset256 ) );
+        vsum = _mm256_srai_epi32( vsum, 3 );
+        vsum = _mm256_packs_epi32( vsum, vsum );
+        vsum = _mm256_permute4x64_epi64( vsum, ( 0 << 0 ) + ( 2 << 2 ) + ( 1 << 4 ) + ( 3 << 6 ) );
+
+        _mm_storeu_si128( ( __m128i* ) &dst[i], _mm256_castsi256_si128( vsum ) );
+      }
+    }
+#endif
+    for( ; i + 4 <= width; i += 4 )
+    {
+      __m128i vrow0 = _mm_loadu_si128( ( const __m128i* ) &src[2 * i] );
+      __m128i vrow1 = _mm_loadu_si128( ( const __m128i* ) &src[2 * i + srcStride] );
+
+      __m128i vsum  = _mm_add_epi32( _mm_madd_epi16( vrow0, vcoeff ), _mm_madd_epi16( vrow1, vcoeff ) );
+      __m128i vodd  = _mm_add_epi32( _mm_srli_epi32( vrow0, 16 ), _mm_srli_epi32( vrow1, 16 ) );
+      __m128i vprev = _mm_or_si128( _mm_slli_si128( vodd, 4 ), _mm_cvtsi32_si128( carry ) );
+      carry         = _mm_extract_epi32( vodd, 3 );
+
+      vsum = _mm_add_epi32( vsum, _mm_add_epi32( vprev, voffset ) );
+      vsum = _mm_srai_epi32( vsum, 3 );
+      vsum = _mm_packs_epi32( vsum, vsum );
+
+      _mm_storel_epi64( ( __m128i* ) &dst[i], vsum );
+    }
+    for( ; i < width; i++ )
+    {
+      if( i == 0 && !leftAvailable )
+      {
+        continue;
+      }
+      dst[i] = ( src[2 * i            ] * 2 + src[2 * i + 1            ] + src[2 * i - 1            ]
+               + src[2 * i + srcStride] * 2 + src[2 * i + 1 + srcStride] + src[2 * i - 1 + srcStride]
+               + 4 ) >> 3;
+    }
+
+    if( !leftAvailable )
+    {
+      dst[0] = ( src[0] + src[srcStride] + 1 ) >> 1;
+    }
+
+    src += srcStride << 1;
+    dst += dstStride;
+  }
+}
+
+template< X86_VEXT vext >
+Void lumaFilterGroup_SSE( const Pel* src, Int srcStride, Pel* const dst[LM_FILTER_NUM], Int dstStride, Int width, Int height )
+{
+  const __m128i vone   = _mm_set1_epi16( 1 );
+  const __m128i vrnd1  = _mm_set1_epi32( 1 );
+  const __m128i vrnd2  = _mm_set1_epi32( 2 );
+#ifdef USE_AVX2
+  const __m256i vone256  = _mm256_set1_epi16( 1 );
+  const __m256i vrnd1256 = _mm256_set1_epi32( 1 );
+  const __m256i vrnd2256 = _mm256_set1_epi32( 2 );
+#endif
+
+  for( Int j = 0; j < height; j++ )
+  {
+    const Pel* piSrc = src + ( j * srcStride << 1 );
+    const Int  iOffs = j * dstStride;
+    Int        i     = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; i + 8 <= width; i += 8 )
+      {
+        __m256i vrow0 = _mm256_loadu_si256( ( const __m256i* ) &piSrc[2 * i] );
+        __m256i vrow1 = _mm256_loadu_si256( ( const __m256i* ) &piSrc[2 * i + srcStride] );
+
+        __m256i vodd  = _mm256_add_epi32( _mm256_srli_epi32( vrow0, 16 ), _mm256_srli_epi32( vrow1, 16 ) );
+        __m256i vpair0 = _mm256_madd_epi16( vrow0, vone256 );
+        __m256i vpair1 = _mm256_madd_epi16( vrow1, vone256 );
+        __m256i vquad  = _mm256_add_epi32( vpair0, vpair1 );
+
+        __m256i vres[LM_FILTER_NUM];
+        vres[0] = _mm256_srai_epi32( _mm256_add_epi32( vodd,   vrnd1256 ), 1 );
+        vres[1] = _mm256_srai_epi32( _mm256_add_epi32( vpair1, vrnd1256 ), 1 );
+        vres[2] = _mm256_srai_epi32( _mm256_add_epi32( vquad,  vrnd2256 ), 2 );
+        vres[3] = _mm256_srai_epi32( _mm256_add_epi32( vpair0, vrnd1256 ), 1 );
+
+        for( Int k = 0; k < LM_FILTER_NUM; k++ )
+        {
+          __m256i vval = _mm256_packs_epi32( vres[k], vres[k] );
+          vval = _mm256_permute4x64_epi64( vval, ( 0 << 0 ) + ( 2 << 2 ) + ( 1 << 4 ) + ( 3 << 6 ) );
+          _mm_storeu_si128( ( __m128i* ) &dst[k][iOffs + i], _mm256_castsi256_si128( vval ) );
+        }
+      }
+    }
+#endif
+    for( ; i + 4 <= width; i += 4 )
+    {
+      __m128i vrow0 = _mm_loadu_si128( ( const __m128i* ) &piSrc[2 * i] );
+      __m128i vrow1 = _mm_loadu_si128( ( const __m128i* ) &piSrc[2 * i + srcStride] );
+
+      __m128i vodd   = _mm_add_epi32( _mm_srli_epi32( vrow0, 16 ), _mm_srli_epi32( vrow1, 16 ) );
+      __m128i vpair0 = _mm_madd_epi16( vrow0, vone );
+      __m128i vpair1 = _mm_madd_epi16( vrow1, vone );
+      __m128i vquad  = _mm_add_epi32( vpair0, vpair1 );
+
+      __m128i vres[LM_FILTER_NUM];
+      vres[0] = _mm_srai_epi32( _mm_add_epi32( vodd,   vrnd1 ), 1 );
+      vres[1] = _mm_srai_epi32( _mm_add_epi32( vpair1, vrnd1 ), 1 );
+      vres[2] = _mm_srai_epi32( _mm_add_epi32( vquad,  vrnd2 ), 2 );
+      vres[3] = _mm_srai_epi32( _mm_add_epi32( vpair0, vrnd1 ), 1 );
+
+      for( Int k = 0; k < LM_FILTER_NUM; k++ )
+      {
+        _mm_storel_epi64( ( __m128i* ) &dst[k][iOffs + i], _mm_packs_epi32( vres[k], vres[k] ) );
+      }
+    }
+    for( ; i < width; i++ )
+    {
+      const Pel* s = piSrc + 2 * i;
+
+      dst[0][iOffs + i] = ( s[1] + s[srcStride + 1] + 1 ) >> 1;
+      dst[1][iOffs + i] = ( s[srcStride] + s[srcStride + 1] + 1 ) >> 1;
+      dst[3][iOffs + i] = ( s[0] + s[1] + 1 ) >> 1;
+      dst[2][iOffs + i] = ( s[0] + s[1] + s[srcStride] + s[srcStride + 1] + 2 ) >> 2;
+    }
+  }
+}
+
+template< X86_VEXT vext >
+Void lmAccumulate_SSE( const Pel* src, const Pel* cur, Int num, Int& x, Int& y, Int& xx, Int& xy )
+{
+  const __m128i vone = _mm_set1_epi16( 1 );
+  __m128i vx  = _mm_setzero_si128();
+  __m128i vy  = _mm_setzero_si128();
+  __m128i vxx = _mm_setzero_si128();
+  __m128i vxy = _mm_setzero_si128();
+  Int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && num >= 16 )
+  {
+    const __m256i vone256 = _mm256_set1_epi16( 1 );
+    __m256i vx256  = _mm256_setzero_si256();
+    __m256i vy256  = _mm256_setzero_si256();
+    __m256i vxx256 = _mm256_setzero_si256();
+    __m256i vxy256 = _mm256_setzero_si256();
+
+    for( ; i + 16 <= num; i += 16 )
+    {
+      __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &src[i] );
+      __m256i vcur = _mm256_loadu_si256( ( const __m256i* ) &cur[i] );
+
+      vx256  = _mm256_add_epi32( vx256,  _mm256_madd_epi16( vsrc, vone256 ) );
+      vy256  = _mm256_add_epi32( vy256,  _mm256_madd_epi16( vcur, vone256 ) );
+      vxx256 = _mm256_add_epi32( vxx256, _mm256_madd_epi16( vsrc, vsrc ) );
+      vxy256 = _mm256_add_epi32( vxy256, _mm256_madd_epi16( vsrc, vcur ) );
+    }
+
+    vx  = _mm_add_epi32( _mm256_castsi256_si128( vx256  ), _mm256_extracti128_si256( vx256,  1 ) );
+    vy  = _mm_add_epi32( _mm256_castsi256_si128( vy256  ), _mm256_extracti128_si256( vy256,  1 ) );
+    vxx = _mm_add_epi32( _mm256_castsi256_si128( vxx256 ), _mm256_extracti128_si256( vxx256, 1 ) );
+    vxy = _mm_add_epi32( _mm256_castsi256_si128( vxy256 ), _mm256_extracti128_si256( vxy256, 1 ) );
+  }
+#endif
+  for( ; i + 8 <= num; i += 8 )
+  {
+    __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[i] );
+    __m128i vcur = _mm_loadu_si128( ( const __m128i* ) &cur[i] );
+
+    vx  = _mm_add_epi32( vx,  _mm_madd_epi16( vsrc, vone ) );
+    vy  = _mm_add_epi32( vy,  _mm_madd_epi16( vcur, vone ) );
+    vxx = _mm_add_epi32( vxx, _mm_madd_epi16( vsrc, vsrc ) );
+    vxy = _mm_add_epi32( vxy, _mm_madd_epi16( vsrc, vcur ) );
+  }
+
+  // horizontal reduction of the four accumulators at once
+  __m128i vxy01 = _mm_hadd_epi32( vx,  vy  );
+  __m128i vxy23 = _mm_hadd_epi32( vxx, vxy );
+  __m128i vsum  = _mm_hadd_epi32( vxy01, vxy23 );
+
+  x  += _mm_extract_epi32( vsum, 0 );
+  y  += _mm_extract_epi32( vsum, 1 );
+  xx += _mm_extract_epi32( vsum, 2 );
+  xy += _mm_extract_epi32( vsum, 3 );
+
+  for( ; i < num; i++ )
+  {
+    x  += src[i];
+    y  += cur[i];
+    xx += src[i] * src[i];
+    xy += src[i] * cur[i];
+  }
+}
+
+template< X86_VEXT vext >
+Void lmPredTwoModel_SSE( const Pel* luma, Int lumaStride, Pel* dst, Int dstStride, Int width, Int height, Int threshold, const Int a[2], const Int b[2], const Int shift[2], const ClpRng& clpRng )
+{
+  const __m128i va0     = _mm_set1_epi32( a[0] );
+  const __m128i va1     = _mm_set1_epi32( a[1] );
+  const __m128i vb0     = _mm_set1_epi32( b[0] );
+  const __m128i vb1     = _mm_set1_epi32( b[1] );
+  const __m128i vshift0 = _mm_cvtsi32_si128( shift[0] );
+  const __m128i vshift1 = _mm_cvtsi32_si128( shift[1] );
+  const __m128i vthres  = _mm_set1_epi32( threshold );
+  const __m128i vbdmin  = _mm_set1_epi16( clpRng.min );
+  const __m128i vbdmax  = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  const __m256i va0256     = _mm256_set1_epi32( a[0] );
+  const __m256i va1256     = _mm256_set1_epi32( a[1] );
+  const __m256i vb0256     = _mm256_set1_epi32( b[0] );
+  const __m256i vb1256     = _mm256_set1_epi32( b[1] );
+  const __m256i vthres256  = _mm256_set1_epi32( threshold );
+#endif
+
+  for( Int j = 0; j < height; j++ )
+  {
+    Int i = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; i + 8 <= width; i += 8 )
+      {
+        __m256i vluma = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &luma[i] ) );
+        __m256i vres0 = _mm256_add_epi32( _mm256_sra_epi32( _mm256_mullo_epi32( vluma, va0256 ), vshift0 ), vb0256 );
+        __m256i vres1 = _mm256_add_epi32( _mm256_sra_epi32( _mm256_mullo_epi32( vluma, va1256 ), vshift1 ), vb1256 );
+        __m256i vres  = _mm256_blendv_epi8( vres0, vres1, _mm256_cmpgt_epi32( vluma, vthres256 ) );
+
+        vres = _mm256_packs_epi32( vres, vres );
+        vres = _mm256_permute4x64_epi64( vres, ( 0 << 0 ) + ( 2 << 2 ) + ( 1 << 4 ) + ( 3 << 6 ) );
+
+        __m128i vdst = _mm256_castsi256_si128( vres );
+        vdst = _mm_min_epi16( vbdmax, _mm_max_epi16( vbdmin, vdst ) );
+        _mm_storeu_si128( ( __m128i* ) &dst[i], vdst );
+      }
+    }
+#endif
+    for( ; i + 4 <= width; i += 4 )
+    {
+      __m128i vluma = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &luma[i] ) );
+      __m128i vres0 = _mm_add_epi32( _mm_sra_epi32( _mm_mullo_epi32( vluma, va0 ), vshift0 ), vb0 );
+      __m128i vres1 = _mm_add_epi32( _mm_sra_epi32( _mm_mullo_epi32( vluma, va1 ), vshift1 ), vb1 );
+      __m128i vres  = _mm_blendv_epi8( vres0, vres1, _mm_cmpgt_epi32( vluma, vthres ) );
+
+      vres = _mm_packs_epi32( vres, vres );
+      vres = _mm_min_epi16( vbdmax, _mm_max_epi16( vbdmin, vres ) );
+      _mm_storel_epi64( ( __m128i* ) &dst[i], vres );
+    }
+    for( ; i < width; i++ )
+    {
+      const Int k = luma[i] <= threshold ? 0 : 1;
+
+      dst[i] = ( Pel ) ClipPel( ( ( a[k] * luma[i] ) >> shift[k] ) + b[k], clpRng );
+    }
+
+    luma += lumaStride;
+    dst  += dstStride;
+  }
+}
+
+template<X86_VEXT vext>
+Void IntraPrediction::_initIntraPredictionX86()
+{
+  m_lumaDownsample  = lumaDownsample_SSE<vext>;
+  m_lumaFilterGroup = lumaFilterGroup_SSE<vext>;
+  m_lmAccumulate    = lmAccumulate_SSE<vext>;
+  m_lmPredTwoModel  = lmPredTwoModel_SSE<vext>;
+}
+
+template Void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
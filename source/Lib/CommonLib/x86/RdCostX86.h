@@ -300,6 +300,127 @@ Distortion RdCost::xGetSAD_SIMD( const DistParam &rcDtParam )
 }
 
 
+#if JEM_TOOLS
+template< X86_VEXT vext >
+Void RdCost::xGetSADWindow_SIMD( const DistParam &rcDtParam, Int range, Distortion* dist )
+{
+  const Int iCols = rcDtParam.org.width;
+  const Int iRows = rcDtParam.org.height;
+
+  if( ( iCols & 3 ) != 0 || rcDtParam.bitDepth > 10 || rcDtParam.applyWeight || rcDtParam.subShift || range > DMVR_INTME_RANGE )
+  {
+    RdCost::xGetSADWindow( rcDtParam, range, dist );
+    return;
+  }
+
+  // every org row is loaded once and compared against all displaced cur rows
+  const Int   iWinSize    = 2 * range + 1;
+  const Int   iNumPos     = iWinSize * iWinSize;
+  const Int   iStrideOrg  = rcDtParam.org.stride;
+  const Int   iStrideCur  = rcDtParam.cur.stride;
+  const short* pSrc1      = (const short*)rcDtParam.org.buf;
+  const short* pSrc2      = (const short*)rcDtParam.cur.buf - range * iStrideCur - range;
+
+  __m128i vzero = _mm_setzero_si128();
+  __m128i vsum32[( 2 * DMVR_INTME_RANGE + 1 ) * ( 2 * DMVR_INTME_RANGE + 1 )];
+  __m128i vsum16[( 2 * DMVR_INTME_RANGE + 1 ) * ( 2 * DMVR_INTME_RANGE + 1 )];
+
+  for( Int k = 0; k < iNumPos; k++ )
+  {
+    vsum32[k] = vzero;
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && ( iCols & 15 ) == 0 )
+  {
+    __m256i vzero256 = _mm256_setzero_si256();
+    __m256i vsum32_256[( 2 * DMVR_INTME_RANGE + 1 ) * ( 2 * DMVR_INTME_RANGE + 1 )];
+    __m256i vsum16_256[( 2 * DMVR_INTME_RANGE + 1 ) * ( 2 * DMVR_INTME_RANGE + 1 )];
+
+    for( Int k = 0; k < iNumPos; k++ )
+    {
+      vsum32_256[k] = vzero256;
+    }
+
+    for( Int iY = 0; iY < iRows; iY++ )
+    {
+      for( Int k = 0; k < iNumPos; k++ )
+      {
+        vsum16_256[k] = vzero256;
+      }
+      for( Int iX = 0; iX < iCols; iX += 16 )
+      {
+        __m256i vsrc1 = _mm256_lddqu_si256( ( __m256i* )( &pSrc1[iX] ) );
+
+        for( Int dy = 0, k = 0; dy < iWinSize; dy++ )
+        {
+          for( Int dx = 0; dx < iWinSize; dx++, k++ )
+          {
+            __m256i vsrc2 = _mm256_lddqu_si256( ( __m256i* )( &pSrc2[dy * iStrideCur + dx + iX] ) );
+            vsum16_256[k] = _mm256_add_epi16( vsum16_256[k], _mm256_abs_epi16( _mm256_sub_epi16( vsrc1, vsrc2 ) ) );
+          }
+        }
+      }
+      for( Int k = 0; k < iNumPos; k++ )
+      {
+        __m256i vsumtemp = _mm256_add_epi32( _mm256_unpacklo_epi16( vsum16_256[k], vzero256 ), _mm256_unpackhi_epi16( vsum16_256[k], vzero256 ) );
+        vsum32_256[k] = _mm256_add_epi32( vsum32_256[k], vsumtemp );
+      }
+      pSrc1 += iStrideOrg;
+      pSrc2 += iStrideCur;
+    }
+
+    for( Int k = 0; k < iNumPos; k++ )
+    {
+      vsum32[k] = _mm_add_epi32( _mm256_castsi256_si128( vsum32_256[k] ), _mm256_extracti128_si256( vsum32_256[k], 1 ) );
+    }
+  }
+  else
+#endif
+  {
+    // step of 8, or of 4 with the upper half of the registers left at zero
+    const Bool bStep4 = ( iCols & 7 ) != 0;
+    const Int  iStep  = bStep4 ? 4 : 8;
+
+    for( Int iY = 0; iY < iRows; iY++ )
+    {
+      for( Int k = 0; k < iNumPos; k++ )
+      {
+        vsum16[k] = vzero;
+      }
+      for( Int iX = 0; iX < iCols; iX += iStep )
+      {
+        __m128i vsrc1 = bStep4 ? _mm_loadl_epi64( ( const __m128i* )&pSrc1[iX] ) : _mm_loadu_si128( ( const __m128i* )&pSrc1[iX] );
+
+        for( Int dy = 0, k = 0; dy < iWinSize; dy++ )
+        {
+          for( Int dx = 0; dx < iWinSize; dx++, k++ )
+          {
+            const short* pCur = &pSrc2[dy * iStrideCur + dx + iX];
+            __m128i vsrc2 = bStep4 ? _mm_loadl_epi64( ( const __m128i* )pCur ) : _mm_lddqu_si128( ( const __m128i* )pCur );
+            vsum16[k] = _mm_add_epi16( vsum16[k], _mm_abs_epi16( _mm_sub_epi16( vsrc1, vsrc2 ) ) );
+          }
+        }
+      }
+      for( Int k = 0; k < iNumPos; k++ )
+      {
+        __m128i vsumtemp = _mm_add_epi32( _mm_unpacklo_epi16( vsum16[k], vzero ), _mm_unpackhi_epi16( vsum16[k], vzero ) );
+        vsum32[k] = _mm_add_epi32( vsum32[k], vsumtemp );
+      }
+      pSrc1 += iStrideOrg;
+      pSrc2 += iStrideCur;
+    }
+  }
+
+  for( Int k = 0; k < iNumPos; k++ )
+  {
+    __m128i vsum = _mm_hadd_epi32( vsum32[k], vzero );
+    vsum         = _mm_hadd_epi32( vsum, vzero );
+    dist[k]      = ( Distortion ) ( UInt ) _mm_cvtsi128_si32( vsum ) >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth - 8 );
+  }
+}
+
+#endif
 template< Int iWidth, X86_VEXT vext >
 Distortion RdCost::xGetSAD_NxN_SIMD( const DistParam &rcDtParam )
 {
@@ -2416,6 +2537,9 @@ Void RdCost::_initRdCostX86()
   m_afpDistortFunc[DF_SAD12  ] = RdCost::xGetSAD_SIMD<vext>;
   m_afpDistortFunc[DF_SAD24  ] = RdCost::xGetSAD_SIMD<vext>;
   m_afpDistortFunc[DF_SAD48  ] = RdCost::xGetSAD_SIMD<vext>;
+#if JEM_TOOLS
+  m_fpSADWindow                = RdCost::xGetSADWindow_SIMD<vext>;
+#endif
 
   m_afpDistortFunc[DF_HAD]     = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
   m_afpDistortFunc[DF_HAD2]    = RdCost::xGetHADs_SIMD<Pel, Pel, vext>;
@@ -1766,7 +1766,7 @@ void CABACReader::prediction_unit( PredictionUnit& pu, MergeCtx& mrgCtx )
         mvd_coding( affLT );
         mvd_coding( affRT );
 
-        PU::setAllAffineMvd( pu.getMotionBuf(), affLT, affRT, REF_PIC_LIST_0, pu.cs->pcv->rectCUs );
+        PU::setAffineMvd( pu, affLT, affRT, REF_PIC_LIST_0 );
       }
       else
 #endif
@@ -1795,7 +1795,7 @@ void CABACReader::prediction_unit( PredictionUnit& pu, MergeCtx& mrgCtx )
         mvd_coding( affLT );
         mvd_coding( affRT );
 
-        PU::setAllAffineMvd( pu.getMotionBuf(), affLT, affRT, REF_PIC_LIST_1, pu.cs->pcv->rectCUs );
+        PU::setAffineMvd( pu, affLT, affRT, REF_PIC_LIST_1 );
       }
 #endif
       else
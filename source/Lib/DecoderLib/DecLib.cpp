@@ -508,6 +508,9 @@ Void DecLib::executeLoopFilters()
 
   CodingStructure& cs = *m_pcPic->cs;
 
+  // keep the motion needed when the picture is used as collocated picture
+  cs.storeColMotion();
+
   // deblocking filter
   m_cLoopFilter.loopFilterPic( cs );
 
@@ -610,6 +613,7 @@ Void DecLib::finishPicture(Int& poc, PicList*& rpcListPic, MsgLevel msgl )
 
   m_pcPic->destroyTempBuffers();
   m_pcPic->cs->destroyCoeffs();
+  m_pcPic->cs->destroyMotionBufs();
   m_pcPic->cs->releaseIntermediateData();
 }
 
@@ -678,6 +682,10 @@ Void DecLib::xCreateLostPicture(Int iLostPoc)
   }
 
 //  for(Int ctuRsAddr=0; ctuRsAddr<cFillPic->getNumberOfCtusInFrame(); ctuRsAddr++)  { cFillPic->getCtu(ctuRsAddr)->initCtu(cFillPic, ctuRsAddr); }
+  // the concealed picture carries no motion, when used as collocated picture all of its blocks read as intra
+  cFillPic->cs->createMotionBufs();
+  cFillPic->cs->storeColMotion();
+  cFillPic->cs->destroyMotionBufs();
   cFillPic->referenced = true;
   cFillPic->slices[0]->setPOC(iLostPoc);
   xUpdatePreviousTid0POC(cFillPic->slices[0]);
@@ -731,6 +739,7 @@ Void DecLib::xActivateParameterSets()
 
     m_pcPic->createTempBuffers( m_pcPic->cs->pps->pcv->maxCUWidth );
     m_pcPic->cs->createCoeffs();
+    m_pcPic->cs->createMotionBufs();
 
     m_pcPic->allocateNewSlice();
     // make the slice-pilot a real slice, and set up the slice-pilot for the next slice
@@ -37,6 +37,7 @@
 
 #include "AQp.h"
 #include <float.h>
+#include <algorithm>
 
 //! \ingroup EncoderLib
 //! \{
@@ -61,6 +62,28 @@ AQpLayer::~AQpLayer()
 
 
 
+/** Append the unit and quadrant boundaries of one layer along one dimension
+ * \param bounds   list of boundary positions
+ * \param size     picture size along the dimension
+ * \param partSize unit size along the dimension
+ */
+static Void addQuadrantBounds( std::vector<Int>& bounds, const Int size, const UInt partSize )
+{
+  for ( Int pos = 0; pos < size; pos += partSize )
+  {
+    const Int currPartSize = std::min<Int>( partSize, size - pos );
+    bounds.push_back( pos + ( currPartSize >> 1 ) );
+    bounds.push_back( pos + currPartSize );
+  }
+}
+
+/** Sum over the rectangle between the boundaries x0, x1 and y0, y1 of an integral image sampled at the boundary crossings
+ */
+static inline UInt64 getRectSum( const std::vector<UInt64>& integral, const Int stride, const Int x0, const Int x1, const Int y0, const Int y1 )
+{
+  return integral[y1 * stride + x1] - integral[y0 * stride + x1] - integral[y1 * stride + x0] + integral[y0 * stride + x0];
+}
+
 /** Analyze source picture and compute local image characteristics used for QP adaptation
  * \param pcEPic Picture object to be analyzed
  * \return Void
@@ -73,9 +96,70 @@ Void AQpPreanalyzer::preanalyze( Picture* pcEPic )
   const Int iHeight = lumaPlane.height;
   const Int iStride = lumaPlane.stride;
 
+  // the quadrant variances of all layers only need the integral image (sum and sum of squares)
+  // at the crossings of their boundaries, which is built in a single pass over the samples
+  std::vector<Int> aiBoundX( 1, 0 );
+  std::vector<Int> aiBoundY( 1, 0 );
+  for ( UInt d = 0; d < pcEPic->aqlayer.size(); d++ )
+  {
+    addQuadrantBounds( aiBoundX, iWidth,  pcEPic->aqlayer[d]->getAQPartWidth() );
+    addQuadrantBounds( aiBoundY, iHeight, pcEPic->aqlayer[d]->getAQPartHeight() );
+  }
+  std::sort( aiBoundX.begin(), aiBoundX.end() );
+  std::sort( aiBoundY.begin(), aiBoundY.end() );
+  aiBoundX.erase( std::unique( aiBoundX.begin(), aiBoundX.end() ), aiBoundX.end() );
+  aiBoundY.erase( std::unique( aiBoundY.begin(), aiBoundY.end() ), aiBoundY.end() );
+
+  // boundary position to index in the integral image
+  std::vector<Int> aiIdxX( iWidth  + 1, 0 );
+  std::vector<Int> aiIdxY( iHeight + 1, 0 );
+  for ( Int i = 0; i < (Int)aiBoundX.size(); i++ )
+  {
+    aiIdxX[aiBoundX[i]] = i;
+  }
+  for ( Int i = 0; i < (Int)aiBoundY.size(); i++ )
+  {
+    aiIdxY[aiBoundY[i]] = i;
+  }
+
+  const Int iNumSegX   = (Int)aiBoundX.size() - 1;
+  const Int iIntStride = iNumSegX + 1;
+  std::vector<UInt64> auiIntSum  ( iIntStride * aiBoundY.size(), 0 );
+  std::vector<UInt64> auiIntSumSq( iIntStride * aiBoundY.size(), 0 );
+  std::vector<UInt64> auiColSum  ( iNumSegX, 0 );
+  std::vector<UInt64> auiColSumSq( iNumSegX, 0 );
+
+  const Pel* pLineY = lumaPlane.bufAt( 0, 0 );
+  for ( Int k = 1; k < (Int)aiBoundY.size(); k++ )
+  {
+    for ( Int y = aiBoundY[k - 1]; y < aiBoundY[k]; y++ )
+    {
+      for ( Int j = 0; j < iNumSegX; j++ )
+      {
+        UInt64 uiSum   = 0;
+        UInt64 uiSumSq = 0;
+        for ( Int x = aiBoundX[j]; x < aiBoundX[j + 1]; x++ )
+        {
+          uiSum   += pLineY[x];
+          uiSumSq += pLineY[x] * pLineY[x];
+        }
+        auiColSum  [j] += uiSum;
+        auiColSumSq[j] += uiSumSq;
+      }
+      pLineY += iStride;
+    }
+
+    UInt64* pIntSum   = &auiIntSum  [k * iIntStride];
+    UInt64* pIntSumSq = &auiIntSumSq[k * iIntStride];
+    for ( Int j = 0; j < iNumSegX; j++ )
+    {
+      pIntSum  [j + 1] = pIntSum  [j] + auiColSum  [j];
+      pIntSumSq[j + 1] = pIntSumSq[j] + auiColSumSq[j];
+    }
+  }
+
   for ( UInt d = 0; d < pcEPic->aqlayer.size(); d++ )
   {
-    const Pel* pLineY = lumaPlane.bufAt( 0, 0);
     AQpLayer* pcAQLayer = pcEPic->aqlayer[d];
     const UInt uiAQPartWidth = pcAQLayer->getAQPartWidth();
     const UInt uiAQPartHeight = pcAQLayer->getAQPartHeight();
@@ -85,42 +169,17 @@ Void AQpPreanalyzer::preanalyze( Picture* pcEPic )
     for ( UInt y = 0; y < iHeight; y += uiAQPartHeight )
     {
       const UInt uiCurrAQPartHeight = std::min(uiAQPartHeight, iHeight-y);
+      const Int  iY[3] = { aiIdxY[y], aiIdxY[y + ( uiCurrAQPartHeight >> 1 )], aiIdxY[y + uiCurrAQPartHeight] };
       for ( UInt x = 0; x < iWidth; x += uiAQPartWidth, pcAQU++ )
       {
         const UInt uiCurrAQPartWidth = std::min(uiAQPartWidth, iWidth-x);
-        const Pel* pBlkY = &pLineY[x];
-        UInt64 uiSum[4] = {0, 0, 0, 0};
-        UInt64 uiSumSq[4] = {0, 0, 0, 0};
-        UInt by = 0;
-        for ( ; by < uiCurrAQPartHeight>>1; by++ )
+        const Int  iX[3] = { aiIdxX[x], aiIdxX[x + ( uiCurrAQPartWidth >> 1 )], aiIdxX[x + uiCurrAQPartWidth] };
+        UInt64 uiSum[4];
+        UInt64 uiSumSq[4];
+        for ( Int i = 0; i < 4; i++ )
         {
-          UInt bx = 0;
-          for ( ; bx < uiCurrAQPartWidth>>1; bx++ )
-          {
-            uiSum  [0] += pBlkY[bx];
-            uiSumSq[0] += pBlkY[bx] * pBlkY[bx];
-          }
-          for ( ; bx < uiCurrAQPartWidth; bx++ )
-          {
-            uiSum  [1] += pBlkY[bx];
-            uiSumSq[1] += pBlkY[bx] * pBlkY[bx];
-          }
-          pBlkY += iStride;
-        }
-        for ( ; by < uiCurrAQPartHeight; by++ )
-        {
-          UInt bx = 0;
-          for ( ; bx < uiCurrAQPartWidth>>1; bx++ )
-          {
-            uiSum  [2] += pBlkY[bx];
-            uiSumSq[2] += pBlkY[bx] * pBlkY[bx];
-          }
-          for ( ; bx < uiCurrAQPartWidth; bx++ )
-          {
-            uiSum  [3] += pBlkY[bx];
-            uiSumSq[3] += pBlkY[bx] * pBlkY[bx];
-          }
-          pBlkY += iStride;
+          uiSum  [i] = getRectSum( auiIntSum,   iIntStride, iX[i & 1], iX[( i & 1 ) + 1], iY[i >> 1], iY[( i >> 1 ) + 1] );
+          uiSumSq[i] = getRectSum( auiIntSumSq, iIntStride, iX[i & 1], iX[( i & 1 ) + 1], iY[i >> 1], iY[( i >> 1 ) + 1] );
         }
 
         CHECK((uiCurrAQPartWidth&1)!=0,  "Odd part width unsupported");
@@ -147,7 +206,6 @@ Void AQpPreanalyzer::preanalyze( Picture* pcEPic )
         *pcAQU = dActivity;
         dSumAct += dActivity;
       }
-      pLineY += iStride * uiCurrAQPartHeight;
     }
 
     const Double dAvgAct = dSumAct / (pcAQLayer->getNumAQPartInWidth() * pcAQLayer->getNumAQPartInHeight());
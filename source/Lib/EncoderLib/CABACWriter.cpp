@@ -1962,9 +1962,8 @@ void CABACWriter::prediction_unit( const PredictionUnit& pu )
 #if JEM_TOOLS
       if( pu.cu->affine )
       {
-        CMotionBuf mb = pu.getMotionBuf();
-        mvd_coding( mb.at(          0, 0 ).mvdAffi[REF_PIC_LIST_0], 0 );
-        mvd_coding( mb.at( mb.width-1, 0 ).mvdAffi[REF_PIC_LIST_0], 0 );
+        mvd_coding( pu.mvdAffi[REF_PIC_LIST_0][0], 0 );
+        mvd_coding( pu.mvdAffi[REF_PIC_LIST_0][1], 0 );
       }
       else
 #endif
@@ -1985,9 +1984,8 @@ void CABACWriter::prediction_unit( const PredictionUnit& pu )
 #if JEM_TOOLS
         if( pu.cu->affine )
         {
-          CMotionBuf mb = pu.getMotionBuf();
-          mvd_coding( mb.at(          0, 0 ).mvdAffi[REF_PIC_LIST_1], 0 );
-          mvd_coding( mb.at( mb.width-1, 0 ).mvdAffi[REF_PIC_LIST_1], 0 );
+          mvd_coding( pu.mvdAffi[REF_PIC_LIST_1][0], 0 );
+          mvd_coding( pu.mvdAffi[REF_PIC_LIST_1][1], 0 );
         }
         else
 #endif
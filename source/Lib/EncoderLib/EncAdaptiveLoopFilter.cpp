@@ -379,7 +379,9 @@ Void EncAdaptiveLoopFilter::ALFProcess(CodingStructure& cs, ALFParam* pcAlfParam
   Double  dOrigCost;
 
   // calc original cost
-  xCalcRDCostLuma( orgUnitBuf, cRecExtBuf, NULL, uiOrigRate, uiOrigDist, dOrigCost );
+  xCalcBlkSSD( orgUnitBuf.get( COMPONENT_Y ), cRecExtBuf.get( COMPONENT_Y ), m_recBlkSSD );
+  uiOrigDist = xSumBlkSSD( m_recBlkSSD, Area( 0, 0, m_img_width, m_img_height ) );
+  xCalcRDCost( uiOrigDist, NULL, uiOrigRate, dOrigCost );
 
   m_pcBestAlfParam->alf_flag        = 0;
   m_pcBestAlfParam->cu_control_flag = 0;
@@ -403,8 +405,8 @@ Void EncAdaptiveLoopFilter::ALFProcess(CodingStructure& cs, ALFParam* pcAlfParam
   // adaptive tap-length
   xFilterTypeDecision( cs, orgUnitBuf, recExtBuf, recUnitBuf, uiMinRate, uiMinDist, dMinCost, cs.slice);
 
-  // compute RD cost
-  xCalcRDCostLuma( orgUnitBuf, recUnitBuf, m_pcBestAlfParam, uiMinRate, uiMinDist, dMinCost );
+  // compute RD cost, the distortion of the best luma result is known from the decisions
+  xCalcRDCost( uiMinDist, m_pcBestAlfParam, uiMinRate, dMinCost );
 
   // compare RD cost to non-ALF case
   if( dMinCost < dOrigCost )
@@ -879,7 +881,8 @@ Void EncAdaptiveLoopFilter::xCheckReUseFilterSet( CodingStructure& cs, const Pel
   UInt64 uiDist = 0;
 
   xFilterFrame_en(dstUnitBuf, recExtBuf, cFrmAlfParam, cs.slice->clpRng(COMPONENT_Y));
-  uiDist = xCalcSSD(orgUnitBuf, dstUnitBuf, COMPONENT_Y);
+  xCalcBlkSSD( orgUnitBuf.get( COMPONENT_Y ), dstUnitBuf.get( COMPONENT_Y ), m_frmBlkSSD );
+  uiDist = xSumBlkSSD( m_frmBlkSSD, Area( 0, 0, m_img_width, m_img_height ) );
   xCalcRDCost( uiDist, &cFrmAlfParam, uiRate, dCost );
 
   if (dCost < rdMinCost)
@@ -897,7 +900,7 @@ Void EncAdaptiveLoopFilter::xCheckReUseFilterSet( CodingStructure& cs, const Pel
     copyALFParam( m_pcTempAlfParam, &cFrmAlfParam);
     m_pcTempAlfParam->alf_max_depth = uiDepth;
 
-    xSetCUAlfCtrlFlags( cs, orgUnitBuf, recExtBuf, m_tempPelBuf, uiDist, uiDepth, m_pcTempAlfParam); //set up varImg here
+    xSetCUAlfCtrlFlags( cs, orgUnitBuf, recExtBuf, m_tempPelBuf, m_frmBlkSSD, uiDist, uiDepth, m_pcTempAlfParam); //set up varImg here
     xCalcRDCost( uiDist, m_pcTempAlfParam, uiRate, dCost );
     if (dCost < rdMinCost )
     {
@@ -1199,19 +1202,18 @@ Void EncAdaptiveLoopFilter::xStoreInBlockMatrix(const PelUnitBuf& orgUnitBuf, co
     Int tap = m_mapTypeToNumOfTaps[filtType];
 
     Int i, j, k, l, varInd;
-    Int x, y;
     Int fl = tap / 2;
     Int flV = AdaptiveLoopFilter::ALFFlHToFlV(fl);
     Int sqrFiltLength = AdaptiveLoopFilter::ALFTapHToNumCoeff(tap);
     Int fl2 = 9 / 2; //extended size at each side of the frame
-    Int ELocal[m_MAX_SQR_FILT_LENGTH];
-    Int yLocal;
-
-    Double **E, *yy;
     Int count_valid = 0;
 
-
-    const Int *p_pattern = m_patternTab[filtType];
+    // the statistics are accumulated per CTU row into contiguous integer matrices with rows padded to a multiple of 8,
+    // all products are integers, such that the summation order does not matter and the result is independent of the threading
+    const Int  eStride    = ( sqrFiltLength + 7 ) & ~7;
+    const Int  eSize      = sqrFiltLength * eStride;
+    const Int  numCtuRows = ( m_img_height + m_uiMaxCUWidth - 1 ) / m_uiMaxCUWidth;
+    const Int *p_pattern  = m_patternTab[filtType];
 
     memset(m_pixAcc, 0, sizeof(Double) * m_NO_VAR_BINS);
 
@@ -1235,64 +1237,86 @@ Void EncAdaptiveLoopFilter::xStoreInBlockMatrix(const PelUnitBuf& orgUnitBuf, co
       }
     }
 
-    for (i = 0, y = fl2; i<m_img_height; i++, y++)
+#pragma omp parallel if( numCtuRows > 1 )
     {
-      for (j = 0, x = fl2; j<m_img_width; j++, x++)
+      std::vector<Int64> ELocalSum( m_NO_VAR_BINS * eSize, 0 );
+      std::vector<Int64> yLocalSum( m_NO_VAR_BINS * eStride, 0 );
+      std::vector<Int64> pixAccSum( m_NO_VAR_BINS, 0 );
+      std::vector<Bool>  binUsed  ( m_NO_VAR_BINS, false );
+      Int ELocal[( m_MAX_SQR_FILT_LENGTH + 7 ) & ~7];
+
+#pragma omp for schedule(dynamic,1)
+      for (Int ctuRow = 0; ctuRow < numCtuRows; ctuRow++)
       {
-        Int condition = (m_maskBuf.at(j, i) == 0 && count_valid > 0);
-        if (!condition)
+        const Int rowStart = ctuRow * m_uiMaxCUWidth;
+        const Int rowEnd   = std::min<Int>( rowStart + m_uiMaxCUWidth, m_img_height );
+
+        for (Int i = rowStart; i < rowEnd; i++)
         {
-          k = 0;
-          memset(ELocal, 0, sqrFiltLength*sizeof(int));
-          if (m_isGALF)
+          for (Int j = 0; j < m_img_width; j++)
           {
-            varInd = m_varImg[i][j];
-            Int transpose = 0;
-            Int varIndMod = selectTransposeVarInd(varInd, &transpose);
-            yLocal = orgBuf[(i)*orgStride + (j)] - recBufExt[(i)*recStrideExt + (j)];
-            calcMatrixE(ELocal, recBufExt, p_pattern, i, j, flV, fl, transpose, recStrideExt);
-            E = m_EGlobalSym[filtType][varIndMod];
-            yy = m_yGlobalSym[filtType][varIndMod];
-
-            for (k = 0; k < sqrFiltLength; k++)
+            Int condition = (m_maskBuf.at(j, i) == 0 && count_valid > 0);
+            if (condition)
             {
-              for (l = k; l < sqrFiltLength; l++)
-              {
-                E[k][l] += (double)(ELocal[k] * ELocal[l]);
-              }
-              yy[k] += (double)(ELocal[k] * yLocal);
+              continue;
             }
-            m_pixAcc[varIndMod] += (yLocal*yLocal);
-          }
-          else
-          {
-            varInd = m_varImg[i / var_step_size_h][j / var_step_size_w];
-            for (int ii = -flV; ii < 0; ii++)
+
+            Int k = 0, varInd, yLocal;
+            memset(ELocal, 0, eStride*sizeof(int));
+            if (m_isGALF)
             {
-              for (int jj = -fl - ii; jj <= fl + ii; jj++)
-              {
-                ELocal[p_pattern[k++]] += (recBufExt[(i + ii)*recStrideExt + (j + jj)] + recBufExt[(i - ii)*recStrideExt + (j - jj)]);
-              }
+              Int transpose = 0;
+              varInd = selectTransposeVarInd(m_varImg[i][j], &transpose);
+              yLocal = orgBuf[(i)*orgStride + (j)] - recBufExt[(i)*recStrideExt + (j)];
+              calcMatrixE(ELocal, recBufExt, p_pattern, i, j, flV, fl, transpose, recStrideExt);
             }
-            for (int jj = -fl; jj<0; jj++)
+            else
             {
-              ELocal[p_pattern[k++]] += (recBufExt[(i)*recStrideExt + (j + jj)] + recBufExt[(i)*recStrideExt + (j - jj)]);
+              varInd = m_varImg[i / var_step_size_h][j / var_step_size_w];
+              for (int ii = -flV; ii < 0; ii++)
+              {
+                for (int jj = -fl - ii; jj <= fl + ii; jj++)
+                {
+                  ELocal[p_pattern[k++]] += (recBufExt[(i + ii)*recStrideExt + (j + jj)] + recBufExt[(i - ii)*recStrideExt + (j - jj)]);
+                }
+              }
+              for (int jj = -fl; jj<0; jj++)
+              {
+                ELocal[p_pattern[k++]] += (recBufExt[(i)*recStrideExt + (j + jj)] + recBufExt[(i)*recStrideExt + (j - jj)]);
+              }
+              ELocal[p_pattern[k++]] += recBufExt[(i)*recStrideExt + (j)];
+              ELocal[sqrFiltLength - 1] = 1;
+              yLocal = orgBuf[(i)*orgStride + (j)];
             }
-            ELocal[p_pattern[k++]] += recBufExt[(i)*recStrideExt + (j)];
-            ELocal[sqrFiltLength - 1] = 1;
-            yLocal = orgBuf[(i)*orgStride + (j)];
 
-            m_pixAcc[varInd] += (yLocal*yLocal);
-            E = m_EGlobalSym[filtType][varInd];
-            yy = m_yGlobalSym[filtType][varInd];
+            pixAccSum[varInd] += (yLocal*yLocal);
+            binUsed  [varInd]  = true;
+            g_pelBufOP.alfAccStats( ELocal, sqrFiltLength, eStride, yLocal, &ELocalSum[varInd * eSize], &yLocalSum[varInd * eStride] );
+          }
+        }
+      }
 
-            for (k = 0; k<sqrFiltLength; k++)
+#pragma omp critical
+      {
+        for (Int varInd = 0; varInd < m_NO_VAR_BINS; varInd++)
+        {
+          if (!binUsed[varInd])
+          {
+            continue;
+          }
+
+          Double **E  = m_EGlobalSym[filtType][varInd];
+          Double  *yy = m_yGlobalSym[filtType][varInd];
+
+          for (Int k = 0; k < sqrFiltLength; k++)
+          {
+            for (Int l = k; l < sqrFiltLength; l++)
             {
-              for (l = k; l<sqrFiltLength; l++)
-                E[k][l] += (double)(ELocal[k] * ELocal[l]);
-              yy[k] += (double)(ELocal[k] * yLocal);
+              E[k][l] += (Double)ELocalSum[varInd * eSize + k * eStride + l];
             }
+            yy[k] += (Double)yLocalSum[varInd * eStride + k];
           }
+          m_pixAcc[varInd] += (Double)pixAccSum[varInd];
         }
       }
     }
@@ -2900,6 +2924,9 @@ Void EncAdaptiveLoopFilter::xCheckCUAdaptation( CodingStructure& cs, const PelUn
   Int    Height = orgUnitBuf.get(COMPONENT_Y).height;
   Int    Width = orgUnitBuf.get(COMPONENT_Y).width;
 
+  // all depths start from the frame filter result, so its block distortions are measured only once
+  xCalcBlkSSD( orgUnitBuf.get( COMPONENT_Y ), recUnitBuf.get( COMPONENT_Y ), m_frmBlkSSD );
+
   for( UInt uiDepth = 0; uiDepth < m_uiMaxTotalCUDepth; uiDepth++ )
   {
     Int nBlkSize = ( cs.slice->getSPS()->getMaxCUHeight() * cs.slice->getSPS()->getMaxCUWidth() ) >> ( uiDepth << 1 );
@@ -2926,11 +2953,12 @@ Void EncAdaptiveLoopFilter::xCheckCUAdaptation( CodingStructure& cs, const PelUn
           m_pcTempAlfParam,
 #endif
           cs.slice->clpRng(COMPONENT_Y) );
+        xCalcBlkSSD( orgUnitBuf.get( COMPONENT_Y ), m_tempPelBuf.get( COMPONENT_Y ), m_filtBlkSSD );
       }
 
       UInt64 uiRate, uiDist;
       Double dCost;
-      xSetCUAlfCtrlFlags( cs, orgUnitBuf, recExtBuf, m_tempPelBuf, uiDist, uiDepth, m_pcTempAlfParam ); //set up varImg here
+      xSetCUAlfCtrlFlags( cs, orgUnitBuf, recExtBuf, m_tempPelBuf, uiRD ? m_filtBlkSSD : m_frmBlkSSD, uiDist, uiDepth, m_pcTempAlfParam ); //set up varImg here
       xCalcRDCost( uiDist, m_pcTempAlfParam, uiRate, dCost );
 
       if (dCost < rdMinCost )
@@ -2972,7 +3000,7 @@ Void EncAdaptiveLoopFilter::xCheckCUAdaptation( CodingStructure& cs, const PelUn
 }
 
 
-Void EncAdaptiveLoopFilter::xSetCUAlfCtrlFlags( CodingStructure& cs, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, UInt64& ruiDist, UInt uiAlfCtrlDepth, ALFParam *pAlfParam )
+Void EncAdaptiveLoopFilter::xSetCUAlfCtrlFlags( CodingStructure& cs, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, const std::vector<UInt64>& filtBlkSSD, UInt64& ruiDist, UInt uiAlfCtrlDepth, ALFParam *pAlfParam )
 {
   ruiDist = 0;
   pAlfParam->num_alf_cu_flag = 0;
@@ -3006,12 +3034,12 @@ Void EncAdaptiveLoopFilter::xSetCUAlfCtrlFlags( CodingStructure& cs, const PelUn
       if( qtDepth >= uiAlfCtrlDepth && cuPos == ctrlPos0 )
       {
         UnitArea ctrlArea( cs.area.chromaFormat, Area( cuPos.x, cuPos.y, std::min( alfCtrlSize, imgWidth-cuPos.x ), std::min( alfCtrlSize, imgHeight-cuPos.y ) ) );
-        xSetCUAlfCtrlFlag( cs, ctrlArea, orgUnitBuf, recExtBuf, recUnitBuf, ruiDist, pAlfParam );
+        xSetCUAlfCtrlFlag( cs, ctrlArea, orgUnitBuf, recExtBuf, recUnitBuf, filtBlkSSD, ruiDist, pAlfParam );
       }
       else if ( (qtDepth < uiAlfCtrlDepth) && cuPos == qtPos0 )
       {
         UnitArea ctrlArea( cs.area.chromaFormat, Area( cuPos.x, cuPos.y, std::min( qtSize, imgWidth-cuPos.x ), std::min( qtSize, imgHeight-cuPos.y ) ) );
-        xSetCUAlfCtrlFlag( cs, ctrlArea, orgUnitBuf, recExtBuf, recUnitBuf, ruiDist, pAlfParam );
+        xSetCUAlfCtrlFlag( cs, ctrlArea, orgUnitBuf, recExtBuf, recUnitBuf, filtBlkSSD, ruiDist, pAlfParam );
       }
     }
   }
@@ -3020,20 +3048,17 @@ Void EncAdaptiveLoopFilter::xSetCUAlfCtrlFlags( CodingStructure& cs, const PelUn
 }
 
 
-Void EncAdaptiveLoopFilter::xSetCUAlfCtrlFlag( CodingStructure& cs, const UnitArea alfCtrlArea, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, UInt64& ruiDist, ALFParam *pAlfParam)
+Void EncAdaptiveLoopFilter::xSetCUAlfCtrlFlag( CodingStructure& cs, const UnitArea alfCtrlArea, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, const std::vector<UInt64>& filtBlkSSD, UInt64& ruiDist, ALFParam *pAlfParam)
 {
 
   const Position& blkPos   = alfCtrlArea.lumaPos();
   const Size&     blkSize  = alfCtrlArea.lumaSize();
 
-  CPelBuf orgBufCUs    = orgUnitBuf.get(COMPONENT_Y).subBuf( blkPos, blkSize );
   CPelBuf recBufCUs    =  recExtBuf.get(COMPONENT_Y).subBuf( blkPos, blkSize );
-
-  CPelBuf cfiltBufCUs  = recUnitBuf.get(COMPONENT_Y).subBuf( blkPos, blkSize );
   UIntBuf  maskBufCUs  = m_maskBuf.subBuf( blkPos, blkSize );
 
-  UInt64 uiRecSSD  = xCalcSSD( orgBufCUs, recBufCUs  );
-  UInt64 uiFiltSSD = xCalcSSD( orgBufCUs, cfiltBufCUs );
+  UInt64 uiRecSSD  = xSumBlkSSD( m_recBlkSSD, Area( blkPos, blkSize ) );
+  UInt64 uiFiltSSD = xSumBlkSSD( filtBlkSSD,  Area( blkPos, blkSize ) );
 
   UInt filterFlag = !!(uiFiltSSD < uiRecSSD );
   maskBufCUs.fill( filterFlag );
@@ -3957,8 +3982,9 @@ Void EncAdaptiveLoopFilter::xFilterTypeDecision(  CodingStructure& cs, const Pel
         m_pcTempAlfParam,
 #endif
         cs.slice->clpRng(COMPONENT_Y));
-       xSetCUAlfCtrlFlags( cs, orgUnitBuf, recExtBuf, m_tempPelBuf, uiDist, m_pcTempAlfParam->alf_max_depth, m_pcTempAlfParam );
-       xCalcRDCostLuma( orgUnitBuf,  m_tempPelBuf, m_pcTempAlfParam, uiRate, uiDist, dCost );
+       xCalcBlkSSD( orgUnitBuf.get( COMPONENT_Y ), m_tempPelBuf.get( COMPONENT_Y ), m_filtBlkSSD );
+       xSetCUAlfCtrlFlags( cs, orgUnitBuf, recExtBuf, m_tempPelBuf, m_filtBlkSSD, uiDist, m_pcTempAlfParam->alf_max_depth, m_pcTempAlfParam );
+       xCalcRDCost( uiDist, m_pcTempAlfParam, uiRate, dCost );
     }
     else
     {
@@ -4095,6 +4121,51 @@ UInt64 EncAdaptiveLoopFilter::xCalcSSD(const CPelBuf& refBuf, const CPelBuf& cmp
   return uiSSD;;
 }
 
+Void EncAdaptiveLoopFilter::xCalcBlkSSD( const CPelBuf& refBuf, const CPelBuf& cmpBuf, std::vector<UInt64>& blkSSD )
+{
+  const Int  blkStride = ( refBuf.width  + ( 1 << MIN_CU_LOG2 ) - 1 ) >> MIN_CU_LOG2;
+  const Int  blkRows   = ( refBuf.height + ( 1 << MIN_CU_LOG2 ) - 1 ) >> MIN_CU_LOG2;
+  const UInt uiShift   = m_nBitIncrement << 1;
+
+  blkSSD.assign( blkStride * blkRows, 0 );
+
+  const Pel* pOrg = refBuf.buf;
+  const Pel* pCmp = cmpBuf.buf;
+
+  for( Int y = 0; y < refBuf.height; y++ )
+  {
+    UInt64* pBlkSSD = &blkSSD[( y >> MIN_CU_LOG2 ) * blkStride];
+
+    for( Int x = 0; x < refBuf.width; x++ )
+    {
+      Int iTemp = pOrg[x] - pCmp[x]; pBlkSSD[x >> MIN_CU_LOG2] += ( iTemp * iTemp ) >> uiShift;
+    }
+    pOrg += refBuf.stride;
+    pCmp += cmpBuf.stride;
+  }
+}
+
+UInt64 EncAdaptiveLoopFilter::xSumBlkSSD( const std::vector<UInt64>& blkSSD, const Area& area ) const
+{
+  CHECKD( ( area.x | area.y ) & ( ( 1 << MIN_CU_LOG2 ) - 1 ), "ALF control area not aligned to the SSD blocks" );
+
+  const Int blkStride = ( m_img_width + ( 1 << MIN_CU_LOG2 ) - 1 ) >> MIN_CU_LOG2;
+  const Int blkX0     = area.x >> MIN_CU_LOG2;
+  const Int blkX1     = ( area.x + area.width  + ( 1 << MIN_CU_LOG2 ) - 1 ) >> MIN_CU_LOG2;
+  const Int blkY1     = ( area.y + area.height + ( 1 << MIN_CU_LOG2 ) - 1 ) >> MIN_CU_LOG2;
+
+  UInt64 uiSSD = 0;
+
+  for( Int blkY = area.y >> MIN_CU_LOG2; blkY < blkY1; blkY++ )
+  {
+    for( Int blkX = blkX0; blkX < blkX1; blkX++ )
+    {
+      uiSSD += blkSSD[blkY * blkStride + blkX];
+    }
+  }
+  return uiSSD;
+}
+
 
 
 //#####################################
@@ -4635,7 +4706,8 @@ Bool EncAdaptiveLoopFilter::xFilteringLumaChroma(CodingStructure& cs, ALFParam *
     xFilterFrame_enAlf(recUnitBuf, recExtBuf, m_pcTempAlfParam->filterType,  m_pcTempAlfParam, false, cs.slice->clpRng(COMPONENT_Y));
   }
 
-  uiDist = xCalcSSD(orgUnitBuf, recUnitBuf, COMPONENT_Y);
+  xCalcBlkSSD( orgUnitBuf.get( COMPONENT_Y ), recUnitBuf.get( COMPONENT_Y ), m_frmBlkSSD );
+  uiDist = xSumBlkSSD( m_frmBlkSSD, Area( 0, 0, m_img_width, m_img_height ) );
   xCalcRDCost(uiDist, m_pcTempAlfParam, uiRate, dCost);
   if (dCost < rdMinCost)
   {
@@ -4665,7 +4737,7 @@ Bool EncAdaptiveLoopFilter::xFilteringLumaChroma(CodingStructure& cs, ALFParam *
     UInt64 uiTmpRate, uiTmpDist;
     Double dTmpCost;
     //m_pcPicYuvTmp: filtered signal, pcPicDec: orig reconst
-    xSetCUAlfCtrlFlags(cs, orgUnitBuf, recExtBuf, m_tempPelBuf, uiTmpDist, uiDepth, m_pcTempAlfParam);
+    xSetCUAlfCtrlFlags(cs, orgUnitBuf, recExtBuf, m_tempPelBuf, m_frmBlkSSD, uiTmpDist, uiDepth, m_pcTempAlfParam);
     xCalcRDCost(uiTmpDist, m_pcTempAlfParam, uiTmpRate, dTmpCost);
     if (dTmpCost < rdMinCost)
     {
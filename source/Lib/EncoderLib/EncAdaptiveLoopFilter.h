@@ -113,8 +113,8 @@ private:
   Void  xSetInitialMask            ( const CPelBuf& recBufExt );
   Void  xInitFixedFilters();
   Void  xCheckCUAdaptation         ( CodingStructure& cs, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, UInt64& ruiMinRate, UInt64& ruiMinDist, Double& rdMinCost );
-  Void  xSetCUAlfCtrlFlags         ( CodingStructure& cs, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, UInt64& ruiDist, UInt uiAlfCtrlDepth, ALFParam *pAlfParam );
-  Void  xSetCUAlfCtrlFlag          ( CodingStructure& cs, const UnitArea alfCtrlArea, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, UInt64& ruiDist, ALFParam *pAlfParam);
+  Void  xSetCUAlfCtrlFlags         ( CodingStructure& cs, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, const std::vector<UInt64>& filtBlkSSD, UInt64& ruiDist, UInt uiAlfCtrlDepth, ALFParam *pAlfParam );
+  Void  xSetCUAlfCtrlFlag          ( CodingStructure& cs, const UnitArea alfCtrlArea, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, const std::vector<UInt64>& filtBlkSSD, UInt64& ruiDist, ALFParam *pAlfParam);
 #if COM16_C806_ALF_TEMPPRED_NUM
   Bool xFilteringLumaChroma(CodingStructure& cs, ALFParam *pAlfParam, const PelUnitBuf& orgUnitBuf, const PelUnitBuf& recExtBuf, PelUnitBuf& recUnitBuf, UInt64& ruiMinRate, UInt64& ruiMinDist, Double& rdMinCost, Int uiIndex, const Slice* pSlice);
   Void xcopyFilterCoeff(int filtNo, int **filterCoeff);
@@ -248,6 +248,8 @@ private:
   Void   xCalcRDCost               ( const UInt64 uiDist, ALFParam* pAlfParam, UInt64& ruiRate,  Double& rdCost );
   UInt64 xCalcSSD                  ( const CPelBuf& refBuf, const CPelBuf& cmpBuf );
   UInt64 xCalcSSD                  ( const CPelUnitBuf& OrgBuf, const CPelUnitBuf& CmpBuf, const ComponentID compId);
+  Void   xCalcBlkSSD               ( const CPelBuf& refBuf, const CPelBuf& cmpBuf, std::vector<UInt64>& blkSSD );
+  UInt64 xSumBlkSSD                ( const std::vector<UInt64>& blkSSD, const Area& area ) const;
   Double xCalcErrorForGivenWeights ( Double** E, Double* y, Double* w, Int size );
   Double calculateErrorAbs         ( Double** A, Double* b, Double y,  Int size );
 
@@ -270,6 +272,11 @@ private:
 
   bool       m_updateMatrix;
   UIntBuf    m_maskBestBuf;
+
+  // luma SSD per 4x4 block, such that the CU on/off decisions sum up cached block distortions instead of re-measuring the frame
+  std::vector<UInt64> m_recBlkSSD;   ///< unfiltered reconstruction, constant within a picture
+  std::vector<UInt64> m_frmBlkSSD;   ///< frame filter result, which all CU control depths start from
+  std::vector<UInt64> m_filtBlkSSD;  ///< result of the latest filter re-design
 #if JVET_C0038_NO_PREV_FILTERS
   Bool bFindBestFixedFilter;
 #endif
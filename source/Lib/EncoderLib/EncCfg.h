@@ -470,6 +470,7 @@ protected:
   Int       m_RCKeepHierarchicalBit;
   Bool      m_RCLCULevelRC;
   Bool      m_RCUseLCUSeparateModel;
+  Bool      m_RCLCULookahead;
   Int       m_RCInitialQP;
   Bool      m_RCForceIntraQP;
 #if U0132_TARGET_BITS_SATURATION
@@ -1228,6 +1229,8 @@ public:
   Void         setLCULevelRC          ( Bool b )                     { m_RCLCULevelRC = b; }
   Bool         getUseLCUSeparateModel ()                             { return m_RCUseLCUSeparateModel; }
   Void         setUseLCUSeparateModel ( Bool b )                     { m_RCUseLCUSeparateModel = b;    }
+  Bool         getLCULookaheadRC      () const                       { return m_RCLCULookahead;        }
+  Void         setLCULookaheadRC      ( Bool b )                     { m_RCLCULookahead = b;           }
   Int          getInitialQP           ()                             { return m_RCInitialQP;           }
   Void         setInitialQP           ( Int QP )                     { m_RCInitialQP = QP;             }
   Bool         getForceIntraQP        ()                             { return m_RCForceIntraQP;        }
@@ -77,6 +77,10 @@ void EncCu::create( EncCfg* encCfg )
 #if JEM_TOOLS
   unsigned      maxMEPart     = BTnoRQT ? 1 : NUMBER_OF_PART_SIZES;
 #endif
+  // the coding structures are only materialized when a block size is visited for the first time, see xGetCS
+  m_chromaFormat     = chromaFormat;
+  m_csPoolMaxMemory  = 0;
+
   m_pTempCS = new CodingStructure**  [numWidths];
   m_pBestCS = new CodingStructure**  [numWidths];
 
@@ -87,21 +91,12 @@ void EncCu::create( EncCfg* encCfg )
 
     for( unsigned h = 0; h < numHeights; h++ )
     {
-      unsigned width  = gp_sizeIdxInfo->sizeFrom( w );
-      unsigned height = gp_sizeIdxInfo->sizeFrom( h );
-
-      if( ( BTnoRQT || w == h ) && gp_sizeIdxInfo->isCuSize( width ) && gp_sizeIdxInfo->isCuSize( height ) )
-      {
-        m_pTempCS[w][h] = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
-        m_pBestCS[w][h] = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
+      m_pTempCS[w][h] = nullptr;
+      m_pBestCS[w][h] = nullptr;
 
-        m_pTempCS[w][h]->create( chromaFormat, Area( 0, 0, width, height ), false );
-        m_pBestCS[w][h]->create( chromaFormat, Area( 0, 0, width, height ), false );
-      }
-      else
+      if( xIsPoolSize( w, h, uiMaxWidth, uiMaxHeight, BTnoRQT ) )
       {
-        m_pTempCS[w][h] = nullptr;
-        m_pBestCS[w][h] = nullptr;
+        m_csPoolMaxMemory += 2 * CodingStructure::getMemorySize( UnitArea( chromaFormat, Area( 0, 0, gp_sizeIdxInfo->sizeFrom( w ), gp_sizeIdxInfo->sizeFrom( h ) ) ) );
       }
     }
   }
@@ -116,21 +111,15 @@ void EncCu::create( EncCfg* encCfg )
 
     for( unsigned w = 0; w < numWidths; w++ )
     {
-      unsigned width  = gp_sizeIdxInfo->sizeFrom( w );
-      unsigned height = gp_sizeIdxInfo->sizeFrom( w );
-
       m_pImvTempCS[w] = new CodingStructure*[maxMEPart];
 
       for( unsigned p = 0; p < maxMEPart; p++ )
       {
-        if( gp_sizeIdxInfo->isCuSize( width ) )
-        {
-          m_pImvTempCS[w][p] = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
-          m_pImvTempCS[w][p]->create( chromaFormat, Area( 0, 0, width, height ), false );
-        }
-        else
+        m_pImvTempCS[w][p] = nullptr;
+
+        if( xIsPoolSize( w, w, uiMaxWidth, uiMaxHeight, BTnoRQT ) )
         {
-          m_pImvTempCS[w][p] = nullptr;
+          m_csPoolMaxMemory += CodingStructure::getMemorySize( UnitArea( chromaFormat, Area( 0, 0, gp_sizeIdxInfo->sizeFrom( w ), gp_sizeIdxInfo->sizeFrom( w ) ) ) );
         }
       }
     }
@@ -153,15 +142,18 @@ void EncCu::create( EncCfg* encCfg )
 
       for( unsigned h = 0; h < numHeights; h++ )
       {
-        UInt width  = gp_sizeIdxInfo->sizeFrom( w );
-        UInt height = gp_sizeIdxInfo->sizeFrom( h );
+        m_pTempCUWoOBMC[w][h] = nullptr;
 
-        if( ( BTnoRQT || w == h ) && gp_sizeIdxInfo->isCuSize( width ) && gp_sizeIdxInfo->isCuSize( height ) )
+        if( xIsPoolSize( w, h, uiMaxWidth, uiMaxHeight, BTnoRQT ) )
         {
+          const UnitArea area( chromaFormat, Area( 0, 0, gp_sizeIdxInfo->sizeFrom( w ), gp_sizeIdxInfo->sizeFrom( h ) ) );
+
+          m_csPoolMaxMemory += CodingStructure::getMemorySize( area );
 
-          m_pTempCUWoOBMC[w][h] = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
-          m_pTempCUWoOBMC[w][h]->create( chromaFormat, Area( 0, 0, width, height ), false );
-          m_pPredBufWoOBMC[w][h].create( UnitArea( chromaFormat, Area( 0, 0, width, height ) ) );
+          for( UInt c = 0; c < getNumberValidComponents( chromaFormat ); c++ )
+          {
+            m_csPoolMaxMemory += area.blocks[c].area() * sizeof( Pel );
+          }
         }
       }
     }
@@ -197,9 +189,8 @@ void EncCu::create( EncCfg* encCfg )
 
 void EncCu::destroy()
 {
-  bool          BTnoRQT   = m_pcEncCfg->getQTBT();
 #if JEM_TOOLS
-  unsigned      maxMEPart = BTnoRQT ? 1 : NUMBER_OF_PART_SIZES;
+  unsigned      maxMEPart = m_pcEncCfg->getQTBT() ? 1 : NUMBER_OF_PART_SIZES;
 #endif
 
   unsigned numWidths  = gp_sizeIdxInfo->numWidths();
@@ -209,14 +200,11 @@ void EncCu::destroy()
   {
     for( unsigned h = 0; h < numHeights; h++ )
     {
-      if( BTnoRQT || w == h )
-      {
-        if( m_pBestCS[w][h] ) m_pBestCS[w][h]->destroy();
-        if( m_pTempCS[w][h] ) m_pTempCS[w][h]->destroy();
+      if( m_pBestCS[w][h] ) m_pBestCS[w][h]->destroy();
+      if( m_pTempCS[w][h] ) m_pTempCS[w][h]->destroy();
 
-        delete m_pBestCS[w][h];
-        delete m_pTempCS[w][h];
-      }
+      delete m_pBestCS[w][h];
+      delete m_pTempCS[w][h];
     }
 
     delete[] m_pTempCS[w];
@@ -255,13 +243,10 @@ void EncCu::destroy()
     {
       for( unsigned h = 0; h < numHeights; h++ )
       {
-        if( ( BTnoRQT || w == h ) && gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( w ) ) && gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( h ) ) )
-        {
-          m_pTempCUWoOBMC[w][h]->destroy();
-          delete m_pTempCUWoOBMC[w][h];
+        if( m_pTempCUWoOBMC[w][h] ) m_pTempCUWoOBMC[w][h]->destroy();
+        delete m_pTempCUWoOBMC[w][h];
 
-          m_pPredBufWoOBMC[w][h].destroy();
-        }
+        m_pPredBufWoOBMC[w][h].destroy();
       }
       delete[] m_pTempCUWoOBMC[w];
       delete[] m_pPredBufWoOBMC[w];
@@ -283,6 +268,40 @@ void EncCu::destroy()
 
 
 
+bool EncCu::xIsPoolSize( const unsigned wIdx, const unsigned hIdx, const unsigned maxWidth, const unsigned maxHeight, const bool BTnoRQT )
+{
+  const unsigned width  = gp_sizeIdxInfo->sizeFrom( wIdx );
+  const unsigned height = gp_sizeIdxInfo->sizeFrom( hIdx );
+
+  return ( BTnoRQT || wIdx == hIdx ) && gp_sizeIdxInfo->isCuSize( width ) && gp_sizeIdxInfo->isCuSize( height ) && width <= maxWidth && height <= maxHeight;
+}
+
+CodingStructure*& EncCu::xGetCS( CodingStructure*& cs, const unsigned wIdx, const unsigned hIdx )
+{
+  if( !cs )
+  {
+    CHECK( !xIsPoolSize( wIdx, hIdx, m_pcEncCfg->getMaxCUWidth(), m_pcEncCfg->getMaxCUHeight(), m_pcEncCfg->getQTBT() ), "Invalid coding structure size requested" );
+
+    cs = new CodingStructure( m_unitCache.cuCache, m_unitCache.puCache, m_unitCache.tuCache );
+    cs->create( m_chromaFormat, Area( 0, 0, gp_sizeIdxInfo->sizeFrom( wIdx ), gp_sizeIdxInfo->sizeFrom( hIdx ) ), false );
+  }
+
+  return cs;
+}
+
+#if JEM_TOOLS
+CodingStructure* EncCu::xGetTempCUWoOBMC( const unsigned wIdx, const unsigned hIdx )
+{
+  if( !m_pTempCUWoOBMC[wIdx][hIdx] )
+  {
+    xGetCS( m_pTempCUWoOBMC[wIdx][hIdx], wIdx, hIdx );
+    m_pPredBufWoOBMC[wIdx][hIdx].create( m_pTempCUWoOBMC[wIdx][hIdx]->area );
+  }
+
+  return m_pTempCUWoOBMC[wIdx][hIdx];
+}
+
+#endif
 EncCu::~EncCu()
 {
 }
@@ -344,8 +363,8 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   // init current context pointer
   m_CurrCtx = m_CtxBuffer.data();
 
-  CodingStructure *tempCS = m_pTempCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
-  CodingStructure *bestCS = m_pBestCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
+  CodingStructure *tempCS = xGetTempCS( gp_sizeIdxInfo->idxFrom( area.lumaSize().width ), gp_sizeIdxInfo->idxFrom( area.lumaSize().height ) );
+  CodingStructure *bestCS = xGetBestCS( gp_sizeIdxInfo->idxFrom( area.lumaSize().width ), gp_sizeIdxInfo->idxFrom( area.lumaSize().height ) );
 
   cs.initSubStructure( *tempCS, partitioner->chType, partitioner->currArea(), false );
   cs.initSubStructure( *bestCS, partitioner->chType, partitioner->currArea(), false );
@@ -586,12 +605,15 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
 
   const UnitArea currCsArea = clipArea( CS::getArea( *bestCS, bestCS->area, partitioner.chType ), *tempCS->picture );
 #if JEM_TOOLS
+  // the neighbouring reconstruction may have changed since the last CU, LIC models can only be shared between its modes
+  m_pcInterSearch->resetLICParamCache();
+
   if( m_pImvTempCS && !slice.isIntra() )
   {
     const unsigned maxMEPart = tempCS->pcv->only2Nx2N ? 1 : NUMBER_OF_PART_SIZES;
     for( unsigned p = 0; p < maxMEPart; p++ )
     {
-      tempCS->initSubStructure( *m_pImvTempCS[wIdx][p], partitioner.chType, partitioner.currArea(), false );
+      tempCS->initSubStructure( *xGetCS( m_pImvTempCS[wIdx][p], wIdx, wIdx ), partitioner.chType, partitioner.currArea(), false );
     }
   }
 #endif
@@ -599,7 +621,7 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
 #if JEM_TOOLS
   if( m_pTempCUWoOBMC && !slice.isIntra() )
   {
-    tempCS->initSubStructure( *m_pTempCUWoOBMC[wIdx][hIdx], partitioner.chType, partitioner.currArea(), false );
+    tempCS->initSubStructure( *xGetTempCUWoOBMC( wIdx, hIdx ), partitioner.chType, partitioner.currArea(), false );
   }
 #endif
 
@@ -886,8 +908,8 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
       jobBlkCache->tick();
     }
 
-    CodingStructure *&jobBest = jobCuEnc->m_pBestCS[wIdx][hIdx];
-    CodingStructure *&jobTemp = jobCuEnc->m_pTempCS[wIdx][hIdx];
+    CodingStructure *&jobBest = jobCuEnc->xGetBestCS( wIdx, hIdx );
+    CodingStructure *&jobTemp = jobCuEnc->xGetTempCS( wIdx, hIdx );
 
     jobUsed[jId] = true;
 
@@ -906,9 +928,9 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
   {
     EncCu* jobCuEnc = m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( jId ) );
 
-    if( jobUsed[jId] && jobCuEnc->m_pBestCS[wIdx][hIdx]->cost < bestCost )
+    if( jobUsed[jId] && jobCuEnc->xGetBestCS( wIdx, hIdx )->cost < bestCost )
     {
-      bestCost = jobCuEnc->m_pBestCS[wIdx][hIdx]->cost;
+      bestCost = jobCuEnc->xGetBestCS( wIdx, hIdx )->cost;
       bestJId  = jId;
     }
   }
@@ -918,8 +940,8 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
     copyState( m_pcEncLib->getCuEncoder( picture->scheduler.getSplitDataId( bestJId ) ), partitioner, currArea, false );
     m_CurrCtx->best = m_CABACEstimator->getCtx();
 
-    tempCS = m_pTempCS[wIdx][hIdx];
-    bestCS = m_pBestCS[wIdx][hIdx];
+    tempCS = xGetTempCS( wIdx, hIdx );
+    bestCS = xGetBestCS( wIdx, hIdx );
   }
 
   const int      bitDepthY = tempCS->sps->getBitDepth( CH_L );
@@ -952,13 +974,13 @@ void EncCu::copyState( EncCu* other, Partitioner& partitioner, const UnitArea& c
 
   if( isDist )
   {
-    other->m_pBestCS[wIdx][hIdx]->initSubStructure( *m_pBestCS[wIdx][hIdx], partitioner.chType, partitioner.currArea(), false );
-    other->m_pTempCS[wIdx][hIdx]->initSubStructure( *m_pTempCS[wIdx][hIdx], partitioner.chType, partitioner.currArea(), false );
+    other->xGetBestCS( wIdx, hIdx )->initSubStructure( *xGetBestCS( wIdx, hIdx ), partitioner.chType, partitioner.currArea(), false );
+    other->xGetTempCS( wIdx, hIdx )->initSubStructure( *xGetTempCS( wIdx, hIdx ), partitioner.chType, partitioner.currArea(), false );
   }
   else
   {
-          CodingStructure* dst =        m_pBestCS[wIdx][hIdx];
-    const CodingStructure *src = other->m_pBestCS[wIdx][hIdx];
+          CodingStructure* dst =        xGetBestCS( wIdx, hIdx );
+    const CodingStructure *src = other->xGetBestCS( wIdx, hIdx );
     bool keepResi = KEEP_PRED_AND_RESI_SIGNALS;
 
     dst->useSubStructure( *src, partitioner.chType, currArea, KEEP_PRED_AND_RESI_SIGNALS, true, keepResi, keepResi );
@@ -1002,7 +1024,11 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
   m_CABACEstimator->getCtx() = m_CurrCtx->start;
   m_CurrCtx++;
 
-  tempCS->getRecoBuf().fill( 0 );
+  // the sub-CUs cover the whole structure unless it crosses the picture boundary or only one channel type is coded
+  if( !tempCS->picture->Y().contains( tempCS->area.Y() ) || CS::isDualITree( *tempCS ) )
+  {
+    tempCS->getRecoBuf().fill( 0 );
+  }
 
   do
   {
@@ -1013,8 +1039,8 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       const unsigned wIdx    = gp_sizeIdxInfo->idxFrom( subCUArea.lwidth () );
       const unsigned hIdx    = gp_sizeIdxInfo->idxFrom( subCUArea.lheight() );
 
-      CodingStructure *tempSubCS = m_pTempCS[wIdx][hIdx];
-      CodingStructure *bestSubCS = m_pBestCS[wIdx][hIdx];
+      CodingStructure *tempSubCS = xGetTempCS( wIdx, hIdx );
+      CodingStructure *bestSubCS = xGetBestCS( wIdx, hIdx );
 
       tempCS->initSubStructure( *tempSubCS, partitioner.chType, subCUArea, false );
       tempCS->initSubStructure( *bestSubCS, partitioner.chType, subCUArea, false );
@@ -1031,8 +1057,9 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
         return;
       }
 
+      // the reconstruction of the best sub-CU was already committed to the picture at the end of xCompressCU
       bool keepResi = KEEP_PRED_AND_RESI_SIGNALS;
-      tempCS->useSubStructure( *bestSubCS, partitioner.chType, CS::getArea( *tempCS, subCUArea, partitioner.chType ), KEEP_PRED_AND_RESI_SIGNALS, true, keepResi, keepResi );
+      tempCS->useSubStructure( *bestSubCS, partitioner.chType, CS::getArea( *tempCS, subCUArea, partitioner.chType ), KEEP_PRED_AND_RESI_SIGNALS, true, keepResi, keepResi, false );
 
       if(currDepth < pps.getMaxCuDQPDepth())
       {
@@ -86,6 +86,8 @@ private:
 
   XUCache               m_unitCache;
 
+  ChromaFormat          m_chromaFormat;
+  size_t                m_csPoolMaxMemory;
   CodingStructure    ***m_pTempCS;
   CodingStructure    ***m_pBestCS;
 #if JEM_TOOLS
@@ -142,10 +144,21 @@ public:
 
   EncModeCtrl* getModeCtrl  () { return m_modeCtrl; }
 
+  /// memory of the per-size coding structures if every block size allowed by the CTU size gets visited
+  size_t getMaxWorkingSetMemory() const { return m_csPoolMaxMemory; }
+
   ~EncCu();
 
 protected:
 
+  static bool       xIsPoolSize     ( const unsigned wIdx, const unsigned hIdx, const unsigned maxWidth, const unsigned maxHeight, const bool BTnoRQT );
+  CodingStructure*& xGetCS          ( CodingStructure*& cs, const unsigned wIdx, const unsigned hIdx );
+  CodingStructure*& xGetTempCS      ( const unsigned wIdx, const unsigned hIdx ) { return xGetCS( m_pTempCS[wIdx][hIdx], wIdx, hIdx ); }
+  CodingStructure*& xGetBestCS      ( const unsigned wIdx, const unsigned hIdx ) { return xGetCS( m_pBestCS[wIdx][hIdx], wIdx, hIdx ); }
+#if JEM_TOOLS
+  CodingStructure*  xGetTempCUWoOBMC( const unsigned wIdx, const unsigned hIdx );
+#endif
+
   void xCompressCU            ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm );
 #if ENABLE_SPLIT_PARALLELISM
   void xCompressCUParallel    ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm );
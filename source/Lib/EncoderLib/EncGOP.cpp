@@ -301,7 +301,7 @@ EncGOP::EncGOP()
 
 EncGOP::~EncGOP()
 {
-  if( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() )
+  if( m_pcCfg && ( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() ) )
   {
     // reset potential decoder resources
     tryDecodePicture( NULL, 0, std::string("") );
@@ -1602,6 +1602,7 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
 #endif
     pcPic->createTempBuffers( pcPic->cs->pps->pcv->maxCUWidth );
     pcPic->cs->createCoeffs();
+    pcPic->cs->createMotionBufs();
 
     //  Slice data initialization
     pcPic->clearSliceBuffer();
@@ -2016,6 +2017,11 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       }
 #endif
 
+      if ( m_pcCfg->getLCULookaheadRC() )
+      {
+        m_pcSliceEncoder->calCostPicLookahead( pcPic );
+      }
+
       Int sliceQP = m_pcCfg->getInitialQP();
       if ( ( pcSlice->getPOC() == 0 && m_pcCfg->getInitialQP() > 0 ) || ( frameLevel == 0 && m_pcCfg->getForceIntraQP() ) ) // QP is specified
       {
@@ -2029,7 +2035,10 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       }
       else if ( frameLevel == 0 )   // intra case, but use the model
       {
-        m_pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
+        if ( !m_pcCfg->getLCULookaheadRC() )
+        {
+          m_pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
+        }
 
         if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
         {
@@ -2085,6 +2094,11 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
       m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
 
+      if ( m_pcCfg->getLCULookaheadRC() )
+      {
+        m_pcRateCtrl->getRCPic()->getLCULookaheadTargetBits();
+      }
+
       m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
     }
 
@@ -2531,6 +2545,10 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
           avgLambda = lambda;
         }
 
+        if ( m_pcCfg->getLCULookaheadRC() && pcSlice->getSliceType() != I_SLICE )
+        {
+          m_pcRateCtrl->getRCPic()->updateLCUParameters();
+        }
         m_pcRateCtrl->getRCPic()->updateAfterPicture( actualHeadBits, actualTotalBits, avgQP, avgLambda, pcSlice->getSliceType());
         m_pcRateCtrl->getRCPic()->addToPictureLsit( m_pcRateCtrl->getPicList() );
 
@@ -2580,8 +2598,10 @@ Void EncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, PicList& rcListPic,
       iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
     }
 
+    pcPic->cs->storeColMotion();
     pcPic->destroyTempBuffers();
     pcPic->cs->destroyCoeffs();
+    pcPic->cs->destroyMotionBufs();
     pcPic->cs->releaseIntermediateData();
   } // iGOPid-loop
 
@@ -2696,18 +2716,28 @@ UInt64 EncGOP::preLoopFilterPicAndCalcDist( Picture* pcPic )
   CodingStructure& cs = *pcPic->cs;
   m_pcLoopFilter->loopFilterPic( cs );
 
-  const CPelUnitBuf picOrg = pcPic->getRecoBuf();
-  const CPelUnitBuf picRec = cs.getRecoBuf();
+  const PreCalcValues& pcv    = *cs.pcv;
+  const CPelUnitBuf    picOrg = pcPic->getOrigBuf();
+  const CPelUnitBuf    picRec = cs.getRecoBuf();
+  RdCost&              rdCost = *m_pcEncLib->getRdCost();
 
+  // the filtering is done, so the CTU distortions can be accumulated independently
   UInt64 uiDist = 0;
-  for( UInt comp = 0; comp < (UInt)picRec.bufs.size(); comp++)
+#pragma omp parallel for schedule(dynamic,1) reduction(+:uiDist) if( pcv.sizeInCtus > 1 )
+  for( int ctuRsAddr = 0; ctuRsAddr < (int)pcv.sizeInCtus; ctuRsAddr++ )
   {
-    const ComponentID compID = ComponentID(comp);
-    const UInt rshift  = 2 * DISTORTION_PRECISION_ADJUSTMENT(cs.sps->getBitDepth(toChannelType(compID)) - 8);
-#if ENABLE_QPA
-    CHECK( rshift >= 8, "shifts greater than 7 are not supported." );
-#endif
-    uiDist += xFindDistortionPlane( picOrg.get(compID), picRec.get(compID), rshift );
+    const Position ctuPos ( ( ctuRsAddr % pcv.widthInCtus ) << pcv.maxCUWidthLog2, ( ctuRsAddr / pcv.widthInCtus ) << pcv.maxCUHeightLog2 );
+    const UnitArea ctuArea( clipArea( UnitArea( pcv.chrFormat, Area( ctuPos.x, ctuPos.y, pcv.maxCUWidth, pcv.maxCUHeight ) ), *pcPic ) );
+
+    for( UInt comp = 0; comp < (UInt)picRec.bufs.size(); comp++ )
+    {
+      const ComponentID compID   = ComponentID( comp );
+      const CompArea&   area     = ctuArea.blocks[compID];
+      const Int         bitDepth = cs.sps->getBitDepth( toChannelType( compID ) );
+
+      // the luma ID avoids the chroma distortion weighting
+      uiDist += rdCost.getDistPart( picOrg.get( compID ).subBuf( area.pos(), area.size() ), picRec.get( compID ).subBuf( area.pos(), area.size() ), bitDepth, COMPONENT_Y, DF_SSE );
+    }
   }
   return uiDist;
 }
@@ -2922,16 +2952,14 @@ UInt64 EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, co
   }
   else
   {
+    // the integer sum is exact in any order, so the lines can be split over the threads
     uiTotalDiff = 0;
+#pragma omp parallel for schedule(static) reduction(+:uiTotalDiff) if( pic0.area() >= ( 1 << 16 ) )
     for (Int y = 0; y < pic0.height; y++)
     {
-      for (Int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += UInt64(iTemp * iTemp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
+      const Pel* pLine0 = pSrc0 + y * pic0.stride;
+      const Pel* pLine1 = pSrc1 + y * pic1.stride;
+      uiTotalDiff += g_pelBufOP.calcSSE( pLine0, pic0.stride, pLine1, pic1.stride, pic0.width, 1 );
     }
   }
 
@@ -112,18 +112,25 @@ Void EncLib::create ()
   m_cRdCost         = new RdCost             [m_numCuEncStacks];
   m_CtxCache        = new CtxCache           [m_numCuEncStacks];
 
+  size_t cuEncMemory = 0;
+
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     m_cCuEncoder[jId].         create( this );
 #if JEM_TOOLS
     m_bilateralFilter[jId].    create();
 #endif
+    cuEncMemory += m_cCuEncoder[jId].getMaxWorkingSetMemory();
   }
+
+  msg( VERBOSE, "CU encoder working set: up to %.1f MB in %d CU encoders, allocated on demand\n", cuEncMemory / ( 1024.0 * 1024.0 ), m_numCuEncStacks );
 #else
   m_cCuEncoder.         create( this );
 #if JEM_TOOLS
   m_bilateralFilter.    create();
 #endif
+
+  msg( VERBOSE, "CU encoder working set: up to %.1f MB, allocated on demand\n", m_cCuEncoder.getMaxWorkingSetMemory() / ( 1024.0 * 1024.0 ) );
 #endif
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cInterSearch.cacheAssign( &m_cacheModel );
@@ -151,8 +151,9 @@ void EncModeCtrl::xGetMinMaxQP( int& minQP, int& maxQP, const CodingStructure& c
 {
   if( m_pcEncCfg->getUseRateCtrl() )
   {
-    minQP = m_pcRateCtrl->getRCQP();
-    maxQP = m_pcRateCtrl->getRCQP();
+    // with the lookahead allocation the CTU QP comes in as the base QP of the CTU
+    minQP = m_pcEncCfg->getLCULookaheadRC() ? cs.baseQP : m_pcRateCtrl->getRCQP();
+    maxQP = m_pcEncCfg->getLCULookaheadRC() ? cs.baseQP : m_pcRateCtrl->getRCQP();
     return;
   }
 
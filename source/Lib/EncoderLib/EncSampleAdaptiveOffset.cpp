@@ -263,54 +263,47 @@ Void EncSampleAdaptiveOffset::addPreDBFStatistics(std::vector<SAOStatData**>& bl
 
 Void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats, PelUnitBuf& orgYuv, PelUnitBuf& srcYuv, CodingStructure& cs, Bool isCalculatePreDeblockSamples)
 {
-  Bool isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail;
-
   const PreCalcValues& pcv = *cs.pcv;
   const Int numberOfComponents = getNumberValidComponents(pcv.chrFormat);
+  const Int numCtus            = pcv.sizeInCtus;
 
-  size_t lineBufferSize = pcv.maxCUWidth + 1;
-  if (m_signLineBuf1.size() != lineBufferSize)
+  // the CTUs are independent of each other, so the statistics of the picture are gathered in parallel
+#pragma omp parallel for schedule(dynamic,1) if( numCtus > 1 )
+  for( Int ctuRsAddr = 0; ctuRsAddr < numCtus; ctuRsAddr++ )
   {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
+    Bool isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail;
 
-  int ctuRsAddr = 0;
-  for( UInt yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
-  {
-    for( UInt xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const UInt width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const UInt height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+    const UInt xPos   = ( ctuRsAddr % pcv.widthInCtus ) * pcv.maxCUWidth;
+    const UInt yPos   = ( ctuRsAddr / pcv.widthInCtus ) * pcv.maxCUHeight;
+    const UInt width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+    const UInt height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail, isAboveAvail, isAboveLeftAvail );
+    deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail, isAboveAvail, isAboveLeftAvail );
 
-      //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
-      //For simplicity, here only picture boundaries are considered.
+    //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
+    //For simplicity, here only picture boundaries are considered.
 
-      isRightAvail      = (xPos + pcv.maxCUWidth  < pcv.lumaWidth );
-      isBelowAvail      = (yPos + pcv.maxCUHeight < pcv.lumaHeight);
-      isAboveRightAvail = ((yPos > 0) && (isRightAvail));
+    isRightAvail      = (xPos + pcv.maxCUWidth  < pcv.lumaWidth );
+    isBelowAvail      = (yPos + pcv.maxCUHeight < pcv.lumaHeight);
+    isAboveRightAvail = ((yPos > 0) && (isRightAvail));
 
-      for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
-      {
-        const ComponentID compID = ComponentID(compIdx);
-        const CompArea& compArea = area.block( compID );
+    for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+    {
+      const ComponentID compID = ComponentID(compIdx);
+      const CompArea& compArea = area.block( compID );
 
-        Int  srcStride  = srcYuv.get(compID).stride;
-        Pel* srcBlk     = srcYuv.get(compID).bufAt( compArea );
+      Int  srcStride  = srcYuv.get(compID).stride;
+      Pel* srcBlk     = srcYuv.get(compID).bufAt( compArea );
 
-        Int  orgStride  = orgYuv.get(compID).stride;
-        Pel* orgBlk     = orgYuv.get(compID).bufAt( compArea );
+      Int  orgStride  = orgYuv.get(compID).stride;
+      Pel* orgBlk     = orgYuv.get(compID).bufAt( compArea );
 
-        getBlkStats(compID, cs.sps->getBitDepth(toChannelType(compID)), blkStats[ctuRsAddr][compID]
-                  , srcBlk, orgBlk, srcStride, orgStride, compArea.width, compArea.height
-                  , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
-                  , isCalculatePreDeblockSamples
-                  );
-      }
-      ctuRsAddr++;
+      getBlkStats(compID, cs.sps->getBitDepth(toChannelType(compID)), blkStats[ctuRsAddr][compID]
+                , srcBlk, orgBlk, srcStride, orgStride, compArea.width, compArea.height
+                , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
+                , isCalculatePreDeblockSamples
+                );
     }
   }
 }
@@ -897,19 +890,35 @@ Void EncSampleAdaptiveOffset::disabledRate( CodingStructure& cs, SAOBlkParam* re
   }
 }
 
+static Void getEdgeStats( const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride
+                        , Int startX, Int endX, Int startY, Int endY, Int offA, Int offB, Int64* diff, Int64* count )
+{
+  // diff and count point at edge class 0, the class of a sample is sgn(s - s[offA]) + sgn(s - s[offB])
+  if( endX <= startX || endY <= startY )
+  {
+    return;
+  }
+
+  const Pel* srcLine = srcBlk + startY * srcStride + startX;
+  const Pel* orgLine = orgBlk + startY * orgStride + startX;
+
+  g_pelBufOP.saoEdgeStats( srcLine, srcStride, orgLine, orgStride, endX - startX, endY - startY, offA, offB, diff, count );
+}
+
 Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int channelBitDepth, SAOStatData* statsDataTypes
                         , Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height
                         , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail
                         , Bool isCalculatePreDeblockSamples
-                        )
+                        ) const
 {
-  Int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
-  SChar signLeft, signRight, signDown;
+  Int x,y, startX, startY, endX, endY, firstLineStartX, firstLineEndX;
   Int64 *diff, *count;
   Pel *srcLine, *orgLine;
-  Int* skipLinesR = m_skipLinesR[compIdx];
-  Int* skipLinesB = m_skipLinesB[compIdx];
+  const Int* skipLinesR = m_skipLinesR[compIdx];
+  const Int* skipLinesB = m_skipLinesB[compIdx];
 
+  //NOTE: The edge classes are derived directly from the neighbouring samples instead of carrying sign lines from row to row,
+  //such that every region is an independent rectangle which can be processed with SIMD and no shared line buffers are needed.
   for(Int typeIdx=0; typeIdx< NUM_SAO_NEW_TYPES; typeIdx++)
   {
     SAOStatData& statsData= statsDataTypes[typeIdx];
@@ -932,44 +941,13 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
         endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  : (isRightAvail ? width : (width - 1))
                                                  ;
-        for (y=0; y<endY; y++)
-        {
-          signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-          for (x=startX; x<endX; x++)
-          {
-            signRight =  (SChar)sgn(srcLine[x] - srcLine[x+1]);
-            edgeType  =  signRight + signLeft;
-            signLeft  = -signRight;
+        getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, 0, endY, -1, 1, diff, count );
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
-        if(isCalculatePreDeblockSamples)
+        if(isCalculatePreDeblockSamples && isBelowAvail)
         {
-          if(isBelowAvail)
-          {
-            startX = isLeftAvail  ? 0 : 1;
-            endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              signLeft = (SChar)sgn(srcLine[startX] - srcLine[startX-1]);
-              for (x=startX; x<endX; x++)
-              {
-                signRight =  (SChar)sgn(srcLine[x] - srcLine[x+1]);
-                edgeType  =  signRight + signLeft;
-                signLeft  = -signRight;
-
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
-          }
+          startX = isLeftAvail  ? 0 : 1;
+          endX   = isRightAvail ? width : (width -1);
+          getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, endY, endY + skipLinesB[typeIdx], -1, 1, diff, count );
         }
       }
       break;
@@ -977,8 +955,6 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
       {
         diff +=2;
         count+=2;
-        SChar *signUpLine = &m_signLineBuf1[0];
-
         startX = (!isCalculatePreDeblockSamples) ? 0
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : width)
                                                  ;
@@ -987,70 +963,18 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  : width
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
-        if (!isAboveAvail)
-        {
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
-
-        Pel* srcLineAbove = srcLine - srcStride;
-        for (x=startX; x<endX; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLine[x] - srcLineAbove[x]);
-        }
+        getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, startY, endY, -srcStride, srcStride, diff, count );
 
-        Pel* srcLineBelow;
-        for (y=startY; y<endY; y++)
+        if(isCalculatePreDeblockSamples && isBelowAvail)
         {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown  = (SChar)sgn(srcLine[x] - srcLineBelow[x]);
-            edgeType  = signDown + signUpLine[x];
-            signUpLine[x]= -signDown;
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
-        if(isCalculatePreDeblockSamples)
-        {
-          if(isBelowAvail)
-          {
-            startX = 0;
-            endX   = width;
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x]) + sgn(srcLine[x] - srcLineAbove[x]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
-          }
+          getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, 0, width, endY, endY + skipLinesB[typeIdx], -srcStride, srcStride, diff, count );
         }
-
       }
       break;
     case SAO_TYPE_EO_135:
       {
         diff +=2;
         count+=2;
-        SChar *signUpLine, *signDownLine, *signTmpLine;
-
-        signUpLine  = &m_signLineBuf1[0];
-        signDownLine= &m_signLineBuf2[0];
-
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  ;
@@ -1060,72 +984,19 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line's upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX; x<endX+1; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x-1]);
-        }
-
         //1st line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x-1]) - signUpLine[x+1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-        srcLine  += srcStride;
-        orgLine  += orgStride;
-
+        getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, firstLineStartX, firstLineEndX, 0, 1, -srcStride - 1, srcStride + 1, diff, count );
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
+        getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, 1, endY, -srcStride - 1, srcStride + 1, diff, count );
 
-          for (x=startX; x<endX; x++)
-          {
-            signDown = (SChar)sgn(srcLine[x] - srcLineBelow[x+1]);
-            edgeType = signDown + signUpLine[x];
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signDownLine[x+1] = -signDown;
-          }
-          signDownLine[startX] = (SChar)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-          signTmpLine  = signUpLine;
-          signUpLine   = signDownLine;
-          signDownLine = signTmpLine;
-
-          srcLine += srcStride;
-          orgLine += orgStride;
-        }
-        if(isCalculatePreDeblockSamples)
+        if(isCalculatePreDeblockSamples && isBelowAvail)
         {
-          if(isBelowAvail)
-          {
-            startX = isLeftAvail  ? 0     : 1 ;
-            endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x< endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x+1]) + sgn(srcLine[x] - srcLineAbove[x-1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
-          }
+          startX = isLeftAvail  ? 0     : 1 ;
+          endX   = isRightAvail ? width : (width -1);
+          getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, endY, endY + skipLinesB[typeIdx], -srcStride - 1, srcStride + 1, diff, count );
         }
       }
       break;
@@ -1133,8 +1004,6 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
       {
         diff +=2;
         count+=2;
-        SChar *signUpLine = &m_signLineBuf1[1];
-
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
                                                  ;
@@ -1143,73 +1012,23 @@ Void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX-1; x<endX; x++)
-        {
-          signUpLine[x] = (SChar)sgn(srcLineBelow[x] - srcLine[x+1]);
-        }
-
-
         //first line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
                                                           : startX
                                                           ;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX)
                                                           : endX
                                                           ;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) - signUpLine[x-1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-
-        srcLine += srcStride;
-        orgLine += orgStride;
+        getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, firstLineStartX, firstLineEndX, 0, 1, -srcStride + 1, srcStride - 1, diff, count );
 
         //middle lines
-        for (y=1; y<endY; y++)
-        {
-          srcLineBelow = srcLine + srcStride;
-
-          for(x=startX; x<endX; x++)
-          {
-            signDown = (SChar)sgn(srcLine[x] - srcLineBelow[x-1]);
-            edgeType = signDown + signUpLine[x];
+        getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, 1, endY, -srcStride + 1, srcStride - 1, diff, count );
 
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signUpLine[x-1] = -signDown;
-          }
-          signUpLine[endX-1] = (SChar)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-          srcLine  += srcStride;
-          orgLine  += orgStride;
-        }
-        if(isCalculatePreDeblockSamples)
+        if(isCalculatePreDeblockSamples && isBelowAvail)
         {
-          if(isBelowAvail)
-          {
-            startX = isLeftAvail  ? 0     : 1 ;
-            endX   = isRightAvail ? width : (width -1);
-
-            for(y=0; y<skipLinesB[typeIdx]; y++)
-            {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + sgn(srcLine[x] - srcLineAbove[x+1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
-              srcLine  += srcStride;
-              orgLine  += orgStride;
-            }
-          }
+          startX = isLeftAvail  ? 0     : 1 ;
+          endX   = isRightAvail ? width : (width -1);
+          getEdgeStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, endY, endY + skipLinesB[typeIdx], -srcStride + 1, srcStride - 1, diff, count );
         }
       }
       break;
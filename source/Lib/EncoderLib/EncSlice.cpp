@@ -56,7 +56,10 @@ extern recursive_mutex g_cache_mutex;
 // ====================================================================================================================
 
 EncSlice::EncSlice()
- : m_encCABACTableIdx(I_SLICE)
+ : m_dPicRdCostAbort  (MAX_DOUBLE)
+ , m_dPicRdCostLambda (0.0)
+ , m_bPicRdCostAborted(false)
+ , m_encCABACTableIdx (I_SLICE)
 {
 }
 
@@ -978,9 +981,19 @@ Void EncSlice::precompressSlice( Picture* pcPic )
     pcSlice       ->setSliceQp             ( m_viRdPicQp    [uiQpIdx] );
     setUpLambda(pcSlice, m_vdRdPicLambda[uiQpIdx], m_viRdPicQp    [uiQpIdx]);
 
-    // try compress
+    // try compress, the distortion and bits only grow from CTU to CTU, so the trial can stop
+    // as soon as the partial cost reaches the best cost found so far without changing the decision
+    m_dPicRdCostAbort   = dPicRdCostBest;
+    m_dPicRdCostLambda  = dFrameLambda;
+    m_bPicRdCostAborted = false;
+
     compressSlice   ( pcPic, true, m_pcCfg->getFastDeltaQp());
 
+    if( m_bPicRdCostAborted )
+    {
+      continue;
+    }
+
     UInt64 uiPicDist        = m_uiPicDist; // Distortion, as calculated by compressSlice.
     // NOTE: This distortion is the chroma-weighted SSE distortion for the slice.
     //       Previously a standard SSE distortion was calculated (for the entire frame).
@@ -999,6 +1012,9 @@ Void EncSlice::precompressSlice( Picture* pcPic )
     }
   }
 
+  m_dPicRdCostAbort   = MAX_DOUBLE;
+  m_bPicRdCostAborted = false;
+
   // set best values
   pcSlice       ->setSliceQp             ( m_viRdPicQp    [uiQpIdxBest] );
   setUpLambda(pcSlice, m_vdRdPicLambda[uiQpIdxBest], m_viRdPicQp    [uiQpIdxBest]);
@@ -1047,6 +1063,41 @@ Void EncSlice::calCostSliceI(Picture* pcPic) // TODO: this only analyses the fir
   m_pcRateCtrl->getRCPic()->setTotalIntraCost(iSumHadSlice);
 }
 
+Void EncSlice::calCostPicLookahead( Picture* pcPic )
+{
+  const Slice   *pcSlice           = pcPic->slices[0];
+  const PreCalcValues& pcv         = *pcPic->cs->pcv;
+  const Int      bitDepth          = pcSlice->getSPS()->getBitDepth( CHANNEL_TYPE_LUMA );
+  const Int      shift             = bitDepth-8;
+  const Int      offset            = (shift>0)?(1<<(shift-1)):0;
+  const Picture *pcRefPic          = pcSlice->isIntra() ? NULL : pcSlice->getRefPic( REF_PIC_LIST_0, 0 );
+  EncRCPic      *pcRCPic           = m_pcRateCtrl->getRCPic();
+
+  // the cost of a CTU is its intra Hadamard cost, or the Hadamard cost of its difference to the co-located original
+  // of the closest reference when that is cheaper, both taken from the original pictures before any CTU is coded
+  Double dSumCost = 0;
+#pragma omp parallel for schedule(dynamic,1) reduction(+:dSumCost) if( pcv.sizeInCtus > 1 )
+  for( Int ctuRsAddr = 0; ctuRsAddr < (Int)pcv.sizeInCtus; ctuRsAddr++ )
+  {
+    Position pos( (ctuRsAddr % pcv.widthInCtus) * pcv.maxCUWidth, (ctuRsAddr / pcv.widthInCtus) * pcv.maxCUHeight);
+
+    const Int height  = std::min( pcv.maxCUHeight, pcv.lumaHeight - pos.y );
+    const Int width   = std::min( pcv.maxCUWidth,  pcv.lumaWidth  - pos.x );
+    const CompArea blk( COMPONENT_Y, pcv.chrFormat, pos, Size( width, height));
+    Double dCost = (m_pcCuEncoder->updateCtuDataISlice( pcPic->getOrigBuf( blk ) )+offset)>>shift;
+
+    if( pcRefPic )
+    {
+      const Distortion uiInterCost = m_pcRdCost->getDistPart( pcPic->getOrigBuf( blk ), pcRefPic->getOrigBuf( blk ), bitDepth, COMPONENT_Y, DF_HAD );
+      dCost = std::min( dCost, Double( uiInterCost ) );
+    }
+
+    pcRCPic->getLCU( ctuRsAddr ).m_costIntra = dCost;
+    dSumCost += dCost;
+  }
+  pcRCPic->setTotalIntraCost( dSumCost );
+}
+
 /** \param pcPic   picture class
  */
 Void EncSlice::compressSlice( Picture* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP )
@@ -1512,13 +1563,18 @@ void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
       }
       else
       {
-        bpp = pRateCtrl->getRCPic()->getLCUTargetBpp(pcSlice->getSliceType());
-        if ( pcPic->slices[0]->getSliceType() == I_SLICE)
+        if ( pCfg->getLCULookaheadRC() )
+        {
+          estLambda = pRateCtrl->getRCPic()->getLCULookaheadLambdaAndQP( ctuRsAddr, pcSlice->getSliceType(), pcSlice->getSliceQp(), &estQP );
+        }
+        else if ( pcPic->slices[0]->getSliceType() == I_SLICE)
         {
+          bpp       = pRateCtrl->getRCPic()->getLCUTargetBpp(pcSlice->getSliceType());
           estLambda = pRateCtrl->getRCPic()->getLCUEstLambdaAndQP(bpp, pcSlice->getSliceQp(), &estQP);
         }
         else
         {
+          bpp       = pRateCtrl->getRCPic()->getLCUTargetBpp(pcSlice->getSliceType());
           estLambda = pRateCtrl->getRCPic()->getLCUEstLambda( bpp );
           estQP     = pRateCtrl->getRCPic()->getLCUEstQP    ( estLambda, pcSlice->getSliceQp() );
         }
@@ -1537,7 +1593,15 @@ void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
 #endif
       }
 
-      pRateCtrl->setRCQP( estQP );
+      if ( pCfg->getLCULookaheadRC() )
+      {
+        // pass the QP with the CTU instead of through the shared rate control, the CTUs may be compressed in parallel
+        currQP[0] = currQP[1] = estQP;
+      }
+      else
+      {
+        pRateCtrl->setRCQP( estQP );
+      }
     }
 #if ENABLE_QPA
     else if (pCfg->getUsePerceptQPA() && pcSlice->getPPS()->getUseDQP())
@@ -1655,8 +1719,19 @@ void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
         actualQP = cu->qp;
       }
       pRdCost->setLambda(oldLambda, pcSlice->getSPS()->getBitDepths());
-      pRateCtrl->getRCPic()->updateAfterCTU( pRateCtrl->getRCPic()->getLCUCoded(), actualBits, actualQP, actualLambda,
-                                             pcSlice->getSliceType() == I_SLICE ? 0 : pCfg->getLCULevelRC() );
+      if ( pCfg->getLCULookaheadRC() )
+      {
+        // the LCU models are updated in one batch after the picture
+#if ENABLE_WPP_PARALLELISM
+#pragma omp critical
+#endif
+        pRateCtrl->getRCPic()->updateAfterCTU( ctuRsAddr, actualBits, actualQP, actualLambda, false );
+      }
+      else
+      {
+        pRateCtrl->getRCPic()->updateAfterCTU( pRateCtrl->getRCPic()->getLCUCoded(), actualBits, actualQP, actualLambda,
+                                               pcSlice->getSliceType() == I_SLICE ? 0 : pCfg->getLCULevelRC() );
+      }
     }
 #if ENABLE_QPA
     else if (pCfg->getUsePerceptQPA() && pcSlice->getPPS()->getUseDQP())
@@ -1673,6 +1748,12 @@ void EncSlice::encodeCtus( Picture* pcPic, const Bool bCompressEntireSlice, cons
 #if !ENABLE_WPP_PARALLELISM
     m_uiPicTotalBits += actualBits;
     m_uiPicDist       = cs.dist;
+
+    if( double( m_uiPicDist ) + m_dPicRdCostLambda * double( m_uiPicTotalBits ) >= m_dPicRdCostAbort )
+    {
+      m_bPicRdCostAborted = true;
+      break;
+    }
 #endif
 #if ENABLE_WPP_PARALLELISM
     pcPic->scheduler.setReady( ctuXPosInCtus, ctuYPosInCtus );
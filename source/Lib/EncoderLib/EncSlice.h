@@ -85,6 +85,9 @@ private:
   CABACWriter*            m_CABACEstimator;
   UInt64                  m_uiPicTotalBits;                     ///< total bits for the picture
   UInt64                  m_uiPicDist;                          ///< total distortion for the picture
+  Double                  m_dPicRdCostAbort;                    ///< QP candidate trial is aborted once its partial RD cost reaches this value
+  Double                  m_dPicRdCostLambda;                   ///< frame lambda of the partial RD cost
+  Bool                    m_bPicRdCostAborted;                  ///< QP candidate trial was aborted
   std::vector<Double>     m_vdRdPicLambda;                      ///< array of lambda candidates
   std::vector<Double>     m_vdRdPicQp;                          ///< array of picture QP candidates (double-type for lambda)
   std::vector<Int>        m_viRdPicQp;                          ///< array of picture QP candidates (Int-type)
@@ -141,6 +144,7 @@ public:
   Void    precompressSlice    ( Picture* pcPic                                     );      ///< precompress slice for multi-loop slice-level QP opt.
   Void    compressSlice       ( Picture* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP );      ///< analysis stage of slice
   Void    calCostSliceI       ( Picture* pcPic );
+  Void    calCostPicLookahead ( Picture* pcPic );                                             ///< CTU complexity pre-analysis for the lookahead rate control
 
   Void    encodeSlice         ( Picture* pcPic, OutputBitstream* pcSubstreams, UInt &numBinsCoded );
 #if ENABLE_WPP_PARALLELISM
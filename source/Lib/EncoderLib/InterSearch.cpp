@@ -3112,8 +3112,8 @@ Void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
       aacMvd[1][iVerIdx] = cMvBi[1][iVerIdx] - cMvPredBi[1][iRefIdxBi[1]][iVerIdx];
     }
 
-    PU::setAllAffineMvd( pu.getMotionBuf(), aacMvd[0][0], aacMvd[0][1], REF_PIC_LIST_0, pu.cs->pcv->rectCUs );
-    PU::setAllAffineMvd( pu.getMotionBuf(), aacMvd[1][0], aacMvd[1][1], REF_PIC_LIST_1, pu.cs->pcv->rectCUs );
+    PU::setAffineMvd( pu, aacMvd[0][0], aacMvd[0][1], REF_PIC_LIST_0 );
+    PU::setAffineMvd( pu, aacMvd[1][0], aacMvd[1][1], REF_PIC_LIST_1 );
 
     pu.interDir = 3;
 
@@ -3134,7 +3134,7 @@ Void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
     {
       aacMvd[0][iVerIdx] = aacMv[0][iVerIdx] - cMvPred[0][iRefIdx[0]][iVerIdx];
     }
-    PU::setAllAffineMvd( pu.getMotionBuf(), aacMvd[0][0], aacMvd[0][1], REF_PIC_LIST_0, pu.cs->pcv->rectCUs );
+    PU::setAffineMvd( pu, aacMvd[0][0], aacMvd[0][1], REF_PIC_LIST_0 );
     pu.interDir = 1;
     pu.mvpIdx[REF_PIC_LIST_0] = aaiMvpIdx[0][iRefIdx[0]];
     pu.mvpNum[REF_PIC_LIST_0] = aaiMvpNum[0][iRefIdx[0]];
@@ -3152,7 +3152,7 @@ Void InterSearch::xPredAffineInterSearch( PredictionUnit&       pu,
       aacMvd[1][iVerIdx] = aacMv[1][iVerIdx] - cMvPred[1][iRefIdx[1]][iVerIdx];
     }
 
-    PU::setAllAffineMvd( pu.getMotionBuf(), aacMvd[1][0], aacMvd[1][1], REF_PIC_LIST_1, pu.cs->pcv->rectCUs );
+    PU::setAffineMvd( pu, aacMvd[1][0], aacMvd[1][1], REF_PIC_LIST_1 );
     pu.interDir = 2;
     pu.mvpIdx[REF_PIC_LIST_1] = aaiMvpIdx[1][iRefIdx[1]];
     pu.mvpNum[REF_PIC_LIST_1] = aaiMvpNum[1][iRefIdx[1]];
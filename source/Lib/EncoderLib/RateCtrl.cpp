@@ -944,6 +944,25 @@ Void EncRCPic::updateAfterCTU( Int LCUIdx, Int bits, Int QP, Double lambda, Bool
     return;
   }
 
+  xUpdateLCUPara( LCUIdx );
+}
+
+Void EncRCPic::updateLCUParameters()
+{
+  if ( !m_encRCSeq->getUseLCUSeparateModel() )
+  {
+    return;
+  }
+
+  // each LCU only reads back its own model, so updating all of them after the picture gives the same models as updating after each CTU
+  for ( Int LCUIdx = 0; LCUIdx < m_numberOfLCU; LCUIdx++ )
+  {
+    xUpdateLCUPara( LCUIdx );
+  }
+}
+
+Void EncRCPic::xUpdateLCUPara( Int LCUIdx )
+{
   Double alpha = m_encRCSeq->getLCUPara( m_frameLevel, LCUIdx ).m_alpha;
   Double beta  = m_encRCSeq->getLCUPara( m_frameLevel, LCUIdx ).m_beta;
 
@@ -1199,6 +1218,66 @@ Double EncRCPic::getLCUEstLambdaAndQP(Double bpp, Int clipPicQP, Int *estQP)
   return estLambda;
 }
 
+Void EncRCPic::getLCULookaheadTargetBits()
+{
+  // distribute the picture budget ahead of coding, proportionally to the pre-analysed CTU costs
+  for ( Int i=0; i<m_numberOfLCU; i++ )
+  {
+    Double weight = m_totalCostIntra > 0.1 ? m_LCUs[i].m_costIntra / m_totalCostIntra : m_LCUs[i].m_numberOfPixel / (Double)m_numberOfPixel;
+    m_LCUs[i].m_targetBits = max( 1, Int( m_bitsLeft * weight + 0.5 ) );
+  }
+}
+
+Double EncRCPic::getLCULookaheadLambdaAndQP( Int LCUIdx, SliceType eSliceType, Int clipPicQP, Int *estQP )
+{
+  Double bpp = ( Double )m_LCUs[LCUIdx].m_targetBits/( Double )m_LCUs[LCUIdx].m_numberOfPixel;
+  Double estLambda;
+
+  if ( eSliceType == I_SLICE )
+  {
+    Double alpha = m_encRCSeq->getPicPara( m_frameLevel ).m_alpha;
+    Double beta  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
+
+    Double costPerPixel = pow( m_LCUs[LCUIdx].m_costIntra/(Double)m_LCUs[LCUIdx].m_numberOfPixel, BETA1 );
+    estLambda = calculateLambdaIntra( alpha, beta, costPerPixel, bpp );
+  }
+  else
+  {
+    Double alpha;
+    Double beta;
+    if ( m_encRCSeq->getUseLCUSeparateModel() )
+    {
+      alpha = m_encRCSeq->getLCUPara( m_frameLevel, LCUIdx ).m_alpha;
+      beta  = m_encRCSeq->getLCUPara( m_frameLevel, LCUIdx ).m_beta;
+    }
+    else
+    {
+      alpha = m_encRCSeq->getPicPara( m_frameLevel ).m_alpha;
+      beta  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
+    }
+
+    estLambda = alpha * pow( bpp, beta );
+    if ( m_estPicLambda > 0.0 )
+    {
+      estLambda = Clip3( m_estPicLambda * pow( 2.0, -2.0/3.0 ), m_estPicLambda * pow( 2.0, 2.0/3.0 ), estLambda );
+    }
+  }
+
+  // no clipping to the neighbouring CTUs, the estimate only depends on picture level values and can be taken in any CTU order
+  Int minQP = clipPicQP - 2;
+  Int maxQP = clipPicQP + 2;
+
+  Double maxLambda=exp(((Double)(maxQP+0.49)-13.7122)/4.2005);
+  Double minLambda=exp(((Double)(minQP-0.49)-13.7122)/4.2005);
+
+  estLambda = Clip3(minLambda, maxLambda, estLambda);
+
+  *estQP = Int( 4.2005 * log(estLambda) + 13.7122 + 0.5 );
+  *estQP = Clip3(minQP, maxQP, *estQP);
+
+  return estLambda;
+}
+
 RateCtrl::RateCtrl()
 {
   m_encRCSeq = NULL;
@@ -234,7 +234,11 @@ public:
   Double getLCUEstLambda( Double bpp );
   Int    getLCUEstQP( Double lambda, Int clipPicQP );
 
+  Void getLCULookaheadTargetBits();
+  Double getLCULookaheadLambdaAndQP( Int LCUIdx, SliceType eSliceType, Int clipPicQP, Int *estQP );
+
   Void updateAfterCTU( Int LCUIdx, Int bits, Int QP, Double lambda, Bool updateLCUParameter = true );
+  Void updateLCUParameters();
   Void updateAfterPicture( Int actualHeaderBits, Int actualTotalBits, Double averageQP, Double averageLambda, SliceType eSliceType);
 
   Void addToPictureLsit( list<EncRCPic*>& listPreviousPictures );
@@ -244,6 +248,7 @@ public:
 private:
   Int xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP );
   Int xEstPicHeaderBits( list<EncRCPic*>& listPreviousPictures, Int frameLevel );
+  Void xUpdateLCUPara( Int LCUIdx );
 #if V0078_ADAPTIVE_LOWER_BOUND
   Int xEstPicLowerBound( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP );
 #endif
@@ -57,6 +57,22 @@ Int64 xCalcSADvalueWP(const Int   bitDepth,
                       const Int   offset,
                       const Bool  useHighPrecision);
 
+//! calculate the SAD values with the WP parameters and with the default ones in a single pass, adding them to SADWP and SADnoWP.
+static
+Void xCalcSADvaluesWPAndNoWP(const Int   bitDepth,
+                             const Pel  *pOrgPel,
+                             const Pel  *pRefPel,
+                             const Int   width,
+                             const Int   height,
+                             const Int   orgStride,
+                             const Int   refStride,
+                             const Int   log2Denom,
+                             const Int   weight,
+                             const Int   offset,
+                             const Bool  useHighPrecision,
+                                   Int64 &SADWP,
+                                   Int64 &SADnoWP);
+
 //! calculate SAD values for both WP version and non-WP version.
 static
 Int64 xCalcSADvalueWPOptionalClip(const Int   bitDepth,
@@ -98,6 +114,19 @@ Void xCalcHistogram(const Pel  *pPel,
   }
 }
 
+//! histogram of a whole plane, calculated once and then kept in the given cache of the picture
+static
+const std::vector<Int>& xGetHistogram(std::vector<Int> &cache,
+                                      const CPelBuf    &buf,
+                                      const Int         maxPel)
+{
+  if (cache.empty())
+  {
+    xCalcHistogram(buf.buf, cache, buf.width, buf.height, buf.stride, maxPel);
+  }
+  return cache;
+}
+
 static
 Distortion xCalcHistDistortion (const std::vector<Int> &histogram0,
                                 const std::vector<Int> &histogram1)
@@ -244,11 +273,20 @@ WeightPredAnalysis::WeightPredAnalysis()
 //! calculate AC and DC values for current original image
 Void WeightPredAnalysis::xCalcACDCParamSlice(Slice *const slice)
 {
+  // the values are computed over the whole picture, so only its first slice has to calculate them
+  Picture* pcPic = slice->getPic();
+
+  if( pcPic->wpAcDcValid )
+  {
+    slice->setWpAcDcParam(pcPic->wpAcDcParam);
+    return;
+  }
+
   //===== calculate AC/DC value =====
 //  PicYuv*   pPic = slice->getPic()->getPicYuvOrg();
-  const CPelUnitBuf pPic = slice->getPic()->getOrigBuf();
+  const CPelUnitBuf pPic = pcPic->getOrigBuf();
 
-  WPACDCParam weightACDCParam[MAX_NUM_COMPONENT];
+  WPACDCParam *weightACDCParam = pcPic->wpAcDcParam;
 
   for(Int componentIndex = 0; componentIndex < ::getNumberValidComponents(pPic.chromaFormat); componentIndex++)
   {
@@ -264,32 +302,36 @@ Void WeightPredAnalysis::xCalcACDCParamSlice(Slice *const slice)
 
     const Int sample = width*height;
 
+    // the lines are summed up in 32 bit, which the compiler can vectorize, and split over the threads
     Int64 orgDC = 0;
+#pragma omp parallel for schedule(static) reduction(+:orgDC) if( sample >= ( 1 << 16 ) )
+    for(Int y = 0; y < height; y++ )
     {
-      const Pel *pPel = compBuf.buf;
+      const Pel *pPel = compBuf.buf + y * stride;
+      Int lineDC = 0;
 
-      for(Int y = 0; y < height; y++, pPel+=stride )
+      for(Int x = 0; x < width; x++ )
       {
-        for(Int x = 0; x < width; x++ )
-        {
-          orgDC += (Int)( pPel[x] );
-        }
+        lineDC += (Int)( pPel[x] );
       }
+      orgDC += lineDC;
     }
 
     const Int64 orgNormDC = ((orgDC+(sample>>1)) / sample);
 
     Int64 orgAC = 0;
+#pragma omp parallel for schedule(static) reduction(+:orgAC) if( sample >= ( 1 << 16 ) )
+    for(Int y = 0; y < height; y++ )
     {
-      const Pel *pPel = compBuf.buf;
+      const Pel *pPel = compBuf.buf + y * stride;
+      const Int normDC = (Int)orgNormDC;
+      Int lineAC = 0;
 
-      for(Int y = 0; y < height; y++, pPel += stride )
+      for(Int x = 0; x < width; x++ )
       {
-        for(Int x = 0; x < width; x++ )
-        {
-          orgAC += abs( (Int)pPel[x] - (Int)orgNormDC );
-        }
+        lineAC += abs( (Int)pPel[x] - normDC );
       }
+      orgAC += lineAC;
     }
 
     const Int fixedBitShift = (slice->getSPS()->getSpsRangeExtension().getHighPrecisionOffsetsEnabledFlag())?RExt__PREDICTION_WEIGHTING_ANALYSIS_DC_PRECISION:0;
@@ -297,6 +339,7 @@ Void WeightPredAnalysis::xCalcACDCParamSlice(Slice *const slice)
     weightACDCParam[compID].iAC = orgAC;
   }
 
+  pcPic->wpAcDcValid = true;
   slice->setWpAcDcParam(weightACDCParam);
 }
 
@@ -477,117 +520,142 @@ Bool WeightPredAnalysis::xUpdatingWPParameters(Slice *const slice, const Int log
 Bool WeightPredAnalysis::xSelectWPHistExtClip(Slice *const slice, const Int log2Denom, const Bool bDoEnhancement, const Bool bClipInitialSADWP, const Bool bUseHistogram)
 {
 
-  const CPelUnitBuf       pPic             = slice->getPic()->getOrigBuf();
+        Picture          *pcPic            = slice->getPic();
+  const CPelUnitBuf       pPic             = pcPic->getOrigBuf();
   const Int               defaultWeight    = 1<<log2Denom;
   const Int               numPredDir       = slice->isInterP() ? 1 : 2;
   const Bool              useHighPrecision = slice->getSPS()->getSpsRangeExtension().getHighPrecisionOffsetsEnabledFlag();
 
   CHECK(numPredDir > Int(NUM_REF_PIC_LIST_01), "Invalid reference picture list");
 
-  for ( Int refList = 0; refList < numPredDir; refList++ )
+  // the histograms of the whole planes are kept on the pictures, so that each one is only computed once,
+  // they are filled before the references are analysed in parallel
+  if (bUseHistogram)
   {
-    const RefPicList eRefPicList = ( refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
-
-    for ( Int refIdxTemp = 0; refIdxTemp < slice->getNumRefIdx(eRefPicList); refIdxTemp++ )
+    for (Int comp = 0; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
     {
-      Bool  useChromaWeight = false;
+      const ComponentID compID = ComponentID(comp);
+      const Int         maxPel = 1 << slice->getSPS()->getBitDepth(toChannelType(compID));
 
-      for (Int comp = 0; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
+      xGetHistogram(pcPic->wpHistOrg[compID], pPic.get(compID), maxPel);
+
+      for ( Int refList = 0; refList < numPredDir; refList++ )
       {
-        const ComponentID  compID     = ComponentID(comp);
-        const Pel         *pRef       = slice->getRefPic(eRefPicList, refIdxTemp)->getRecoBuf().get(compID).buf;
-        const Int          refStride  = slice->getRefPic(eRefPicList, refIdxTemp)->getRecoBuf().get(compID).stride;;
-        const CPelBuf      compBuf    = pPic.get( compID );
-        const Pel         *pOrg       = compBuf.buf;
-        const Int          orgStride  = compBuf.stride;
-        const Int          width      = compBuf.width;
-        const Int          height     = compBuf.height;
-        const Int          bitDepth   = slice->getSPS()->getBitDepth(toChannelType(compID));
-              WPScalingParam &wp      = m_wp[refList][refIdxTemp][compID];
-              Int          weight     = wp.iWeight;
-              Int          offset     = wp.iOffset;
-              Int          weightDef  = defaultWeight;
-              Int          offsetDef  = 0;
-
-        // calculate SAD costs with/without wp for luma
-        const Int64 SADnoWP = xCalcSADvalueWPOptionalClip(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, defaultWeight, 0, useHighPrecision, bClipInitialSADWP);
-        if (SADnoWP > 0)
+        const RefPicList eRefPicList = ( refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+
+        for ( Int refIdxTemp = 0; refIdxTemp < slice->getNumRefIdx(eRefPicList); refIdxTemp++ )
         {
-          const Int64 SADWP   = xCalcSADvalueWPOptionalClip(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, weight,   offset, useHighPrecision, bClipInitialSADWP);
-          const Double dRatioSAD = (Double)SADWP / (Double)SADnoWP;
-          Double dRatioSr0SAD = std::numeric_limits<Double>::max();
-          Double dRatioSrSAD  = std::numeric_limits<Double>::max();
+          const Picture *pcRefPic = slice->getRefPic(eRefPicList, refIdxTemp);
+          xGetHistogram(pcRefPic->wpHistRec[compID], pcRefPic->getRecoBuf().get(compID), maxPel);
+        }
+      }
+    }
+  }
 
-          if (bUseHistogram)
-          {
-            std::vector<Int> histogramOrg;// = pPic->getHistogram(compID);
-            std::vector<Int> histogramRef;// = slice->getRefPic(eRefPicList, refIdxTemp)->getPicYuvRec()->getHistogram(compID);
-            std::vector<Int> searchedHistogram;
+  // each reference only updates its own parameters
+  const Int numRefIdxL0 = slice->getNumRefIdx(REF_PIC_LIST_0);
+  const Int numRefs     = numRefIdxL0 + (numPredDir > 1 ? slice->getNumRefIdx(REF_PIC_LIST_1) : 0);
 
-            // Compute histograms
-            xCalcHistogram(pOrg, histogramOrg, width, height, orgStride, 1 << bitDepth);
-            xCalcHistogram(pRef, histogramRef, width, height, refStride, 1 << bitDepth);
+#pragma omp parallel for schedule(dynamic,1) if( numRefs > 1 )
+  for ( Int refNum = 0; refNum < numRefs; refNum++ )
+  {
+    const Int         refList     = refNum < numRefIdxL0 ? 0 : 1;
+    const Int         refIdxTemp  = refNum - refList * numRefIdxL0;
+    const RefPicList  eRefPicList = ( refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+    const Picture    *pcRefPic    = slice->getRefPic(eRefPicList, refIdxTemp);
+    Bool  useChromaWeight = false;
 
-            // Do a histogram search around DC WP parameters; resulting distortion and 'searchedHistogram' is discarded
-            xSearchHistogram(histogramOrg, histogramRef, searchedHistogram, bitDepth, log2Denom, weight, offset, useHighPrecision, compID);
-            // calculate updated WP SAD
-            const Int64 SADSrWP = xCalcSADvalueWP(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, weight, offset, useHighPrecision);
-            dRatioSrSAD  = (Double)SADSrWP  / (Double)SADnoWP;
-
-            if (bDoEnhancement)
-            {
-              // Do the same around the default ones; resulting distortion and 'searchedHistogram' is discarded
-              xSearchHistogram(histogramOrg, histogramRef, searchedHistogram, bitDepth, log2Denom, weightDef, offsetDef, useHighPrecision, compID);
-              // calculate updated WP SAD
-              const Int64 SADSr0WP = xCalcSADvalueWP(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, weightDef, offsetDef, useHighPrecision);
-              dRatioSr0SAD = (Double)SADSr0WP / (Double)SADnoWP;
-            }
-          }
+    for (Int comp = 0; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
+    {
+      const ComponentID  compID     = ComponentID(comp);
+      const Pel         *pRef       = pcRefPic->getRecoBuf().get(compID).buf;
+      const Int          refStride  = pcRefPic->getRecoBuf().get(compID).stride;
+      const CPelBuf      compBuf    = pPic.get( compID );
+      const Pel         *pOrg       = compBuf.buf;
+      const Int          orgStride  = compBuf.stride;
+      const Int          width      = compBuf.width;
+      const Int          height     = compBuf.height;
+      const Int          bitDepth   = slice->getSPS()->getBitDepth(toChannelType(compID));
+            WPScalingParam &wp      = m_wp[refList][refIdxTemp][compID];
+            Int          weight     = wp.iWeight;
+            Int          offset     = wp.iOffset;
+            Int          weightDef  = defaultWeight;
+            Int          offsetDef  = 0;
+
+      // calculate SAD costs with/without wp for luma
+      const Int64 SADnoWP = xCalcSADvalueWPOptionalClip(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, defaultWeight, 0, useHighPrecision, bClipInitialSADWP);
+      if (SADnoWP > 0)
+      {
+        const Int64 SADWP   = xCalcSADvalueWPOptionalClip(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, weight,   offset, useHighPrecision, bClipInitialSADWP);
+        const Double dRatioSAD = (Double)SADWP / (Double)SADnoWP;
+        Double dRatioSr0SAD = std::numeric_limits<Double>::max();
+        Double dRatioSrSAD  = std::numeric_limits<Double>::max();
 
-          if(std::min(dRatioSr0SAD, std::min(dRatioSAD, dRatioSrSAD)) >= WEIGHT_PRED_SAD_RELATIVE_TO_NON_WEIGHT_PRED_SAD)
-          {
-            wp.bPresentFlag      = false;
-            wp.iOffset           = 0;
-            wp.iWeight           = defaultWeight;
-            wp.uiLog2WeightDenom = log2Denom;
-          }
-          else
+        if (bUseHistogram)
+        {
+          const std::vector<Int> &histogramOrg = pcPic->wpHistOrg[compID];
+          const std::vector<Int> &histogramRef = pcRefPic->wpHistRec[compID];
+          std::vector<Int> searchedHistogram;
+
+          // Do a histogram search around DC WP parameters; resulting distortion and 'searchedHistogram' is discarded
+          xSearchHistogram(histogramOrg, histogramRef, searchedHistogram, bitDepth, log2Denom, weight, offset, useHighPrecision, compID);
+          // calculate updated WP SAD
+          const Int64 SADSrWP = xCalcSADvalueWP(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, weight, offset, useHighPrecision);
+          dRatioSrSAD  = (Double)SADSrWP  / (Double)SADnoWP;
+
+          if (bDoEnhancement)
           {
-            if (compID != COMPONENT_Y)
-            {
-              useChromaWeight = true;
-            }
-
-            if (dRatioSr0SAD < dRatioSrSAD && dRatioSr0SAD < dRatioSAD)
-            {
-              wp.bPresentFlag      = true;
-              wp.iOffset           = offsetDef;
-              wp.iWeight           = weightDef;
-              wp.uiLog2WeightDenom = log2Denom;
-            }
-            else if (dRatioSrSAD < dRatioSAD)
-            {
-              wp.bPresentFlag      = true;
-              wp.iOffset           = offset;
-              wp.iWeight           = weight;
-              wp.uiLog2WeightDenom = log2Denom;
-            }
+            // Do the same around the default ones; resulting distortion and 'searchedHistogram' is discarded
+            xSearchHistogram(histogramOrg, histogramRef, searchedHistogram, bitDepth, log2Denom, weightDef, offsetDef, useHighPrecision, compID);
+            // calculate updated WP SAD
+            const Int64 SADSr0WP = xCalcSADvalueWP(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, weightDef, offsetDef, useHighPrecision);
+            dRatioSr0SAD = (Double)SADSr0WP / (Double)SADnoWP;
           }
         }
-        else // (SADnoWP <= 0)
+
+        if(std::min(dRatioSr0SAD, std::min(dRatioSAD, dRatioSrSAD)) >= WEIGHT_PRED_SAD_RELATIVE_TO_NON_WEIGHT_PRED_SAD)
         {
           wp.bPresentFlag      = false;
           wp.iOffset           = 0;
           wp.iWeight           = defaultWeight;
           wp.uiLog2WeightDenom = log2Denom;
         }
-      }
+        else
+        {
+          if (compID != COMPONENT_Y)
+          {
+            useChromaWeight = true;
+          }
 
-      for (Int comp = 1; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
+          if (dRatioSr0SAD < dRatioSrSAD && dRatioSr0SAD < dRatioSAD)
+          {
+            wp.bPresentFlag      = true;
+            wp.iOffset           = offsetDef;
+            wp.iWeight           = weightDef;
+            wp.uiLog2WeightDenom = log2Denom;
+          }
+          else if (dRatioSrSAD < dRatioSAD)
+          {
+            wp.bPresentFlag      = true;
+            wp.iOffset           = offset;
+            wp.iWeight           = weight;
+            wp.uiLog2WeightDenom = log2Denom;
+          }
+        }
+      }
+      else // (SADnoWP <= 0)
       {
-        m_wp[refList][refIdxTemp][comp].bPresentFlag = useChromaWeight;
+        wp.bPresentFlag      = false;
+        wp.iOffset           = 0;
+        wp.iWeight           = defaultWeight;
+        wp.uiLog2WeightDenom = log2Denom;
       }
     }
+
+    for (Int comp = 1; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
+    {
+      m_wp[refList][refIdxTemp][comp].bPresentFlag = useChromaWeight;
+    }
   }
 
   return true;
@@ -603,47 +671,50 @@ Bool WeightPredAnalysis::xSelectWP(Slice *const slice, const Int log2Denom)
 
   CHECK(numPredDir > Int(NUM_REF_PIC_LIST_01), "Invalid reference picture list");
 
-  for ( Int refList = 0; refList < numPredDir; refList++ )
+  // each reference only updates its own parameters
+  const Int numRefIdxL0 = slice->getNumRefIdx(REF_PIC_LIST_0);
+  const Int numRefs     = numRefIdxL0 + (numPredDir > 1 ? slice->getNumRefIdx(REF_PIC_LIST_1) : 0);
+
+#pragma omp parallel for schedule(dynamic,1) if( numRefs > 1 )
+  for ( Int refNum = 0; refNum < numRefs; refNum++ )
   {
-    const RefPicList eRefPicList = ( refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+    const Int         refList     = refNum < numRefIdxL0 ? 0 : 1;
+    const Int         refIdxTemp  = refNum - refList * numRefIdxL0;
+    const RefPicList  eRefPicList = ( refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0 );
+    const Picture    *pcRefPic    = slice->getRefPic(eRefPicList, refIdxTemp);
+    Int64 SADWP = 0, SADnoWP = 0;
 
-    for ( Int refIdxTemp = 0; refIdxTemp < slice->getNumRefIdx(eRefPicList); refIdxTemp++ )
+    for (Int comp = 0; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
     {
-      Int64 SADWP = 0, SADnoWP = 0;
-
-      for (Int comp = 0; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
-      {
-        const ComponentID  compID     = ComponentID(comp);
-        const CPelBuf      compBuf    = pPic.get( compID );
-        const Pel         *pRef       = slice->getRefPic(eRefPicList, refIdxTemp)->getRecoBuf().get( compID ).buf;
-        const Int          refStride  = slice->getRefPic(eRefPicList, refIdxTemp)->getRecoBuf().get( compID ).stride;
-        const Pel         *pOrg       = compBuf.buf;
-        const Int          orgStride  = compBuf.stride;
-        const Int          width      = compBuf.width;
-        const Int          height     = compBuf.height;
-        const Int          bitDepth   = slice->getSPS()->getBitDepth(toChannelType(compID));
-
-        // calculate SAD costs with/without wp for luma
-        SADWP   += xCalcSADvalueWP(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, m_wp[refList][refIdxTemp][compID].iWeight, m_wp[refList][refIdxTemp][compID].iOffset, useHighPrecisionPredictionWeighting);
-        SADnoWP += xCalcSADvalueWP(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, defaultWeight, 0, useHighPrecisionPredictionWeighting);
-      }
+      const ComponentID  compID     = ComponentID(comp);
+      const CPelBuf      compBuf    = pPic.get( compID );
+      const Pel         *pRef       = pcRefPic->getRecoBuf().get( compID ).buf;
+      const Int          refStride  = pcRefPic->getRecoBuf().get( compID ).stride;
+      const Pel         *pOrg       = compBuf.buf;
+      const Int          orgStride  = compBuf.stride;
+      const Int          width      = compBuf.width;
+      const Int          height     = compBuf.height;
+      const Int          bitDepth   = slice->getSPS()->getBitDepth(toChannelType(compID));
+
+      // calculate SAD costs with/without wp for luma
+      xCalcSADvaluesWPAndNoWP(bitDepth, pOrg, pRef, width, height, orgStride, refStride, log2Denom, m_wp[refList][refIdxTemp][compID].iWeight, m_wp[refList][refIdxTemp][compID].iOffset, useHighPrecisionPredictionWeighting, SADWP, SADnoWP);
+    }
 
-      const Double dRatio     = SADnoWP > 0 ? (((Double)SADWP / (Double)SADnoWP)) : std::numeric_limits<Double>::max();
+    const Double dRatio     = SADnoWP > 0 ? (((Double)SADWP / (Double)SADnoWP)) : std::numeric_limits<Double>::max();
 #if JEM_TOOLS
-      const Double dMaxRatio  = Double( slice->getSPS()->getSpsNext().getLICMode() ? 0.85 : 0.99 );
+    const Double dMaxRatio  = Double( slice->getSPS()->getSpsNext().getLICMode() ? 0.85 : 0.99 );
 #else
-      const Double dMaxRatio  = Double( 0.99 );
+    const Double dMaxRatio  = Double( 0.99 );
 #endif
-      if(dRatio >= dMaxRatio)
+    if(dRatio >= dMaxRatio)
+    {
+      for(Int comp=0; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
       {
-        for(Int comp=0; comp < ::getNumberValidComponents(pPic.chromaFormat); comp++)
-        {
-          WPScalingParam &wp=m_wp[refList][refIdxTemp][comp];
-          wp.bPresentFlag      = false;
-          wp.iOffset           = 0;
-          wp.iWeight           = defaultWeight;
-          wp.uiLog2WeightDenom = log2Denom;
-        }
+        WPScalingParam &wp=m_wp[refList][refIdxTemp][comp];
+        wp.bPresentFlag      = false;
+        wp.iOffset           = 0;
+        wp.iWeight           = defaultWeight;
+        wp.uiLog2WeightDenom = log2Denom;
       }
     }
   }
@@ -685,6 +756,41 @@ Int64 xCalcSADvalueWP(const Int   bitDepth,
   return SAD;
 }
 
+static
+Void xCalcSADvaluesWPAndNoWP(const Int   bitDepth,
+                             const Pel  *pOrgPel,
+                             const Pel  *pRefPel,
+                             const Int   width,
+                             const Int   height,
+                             const Int   orgStride,
+                             const Int   refStride,
+                             const Int   log2Denom,
+                             const Int   weight,
+                             const Int   offset,
+                             const Bool  useHighPrecision,
+                                   Int64 &SADWP,
+                                   Int64 &SADnoWP)
+{
+  const Int64 realLog2Denom = useHighPrecision ? log2Denom : (log2Denom + (bitDepth - 8));
+  const Int64 realOffset    = ((Int64)offset)<<realLog2Denom;
+
+  // the default weight without offset only scales the plain differences
+  Int64 SADw = 0, SADd = 0;
+  for( Int y = 0; y < height; y++ )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      SADw += abs(( ((Int64)pOrgPel[x] << (Int64) log2Denom) - ( (Int64) pRefPel[x] * (Int64) weight + (realOffset) ) ) );
+      SADd += abs( (Int)pOrgPel[x] - (Int)pRefPel[x] );
+    }
+    pOrgPel += orgStride;
+    pRefPel += refStride;
+  }
+
+  SADWP   += SADw;
+  SADnoWP += SADd << log2Denom;
+}
+
 static
 Int64 xCalcSADvalueWPOptionalClip(const Int   bitDepth,
                                   const Pel  *pOrgPel,
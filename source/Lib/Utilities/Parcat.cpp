@@ -0,0 +1,613 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2015, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     Parcat.cpp
+    \brief    Concatenation of bitstream segments from parallel simulations (JVET-B0036)
+*/
+
+#include "Parcat.h"
+
+#include <stdint.h>
+#include <deque>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PARCAT_USE_MMAP 1
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#else
+#define PARCAT_USE_MMAP 0
+#endif
+
+namespace parcat
+{
+
+enum NalUnitType
+{
+  TRAIL_N = 0, // 0
+  TRAIL_R,     // 1
+
+  TSA_N,       // 2
+  TSA_R,       // 3
+
+  STSA_N,      // 4
+  STSA_R,      // 5
+
+  RADL_N,      // 6
+  RADL_R,      // 7
+
+  RASL_N,      // 8
+  RASL_R,      // 9
+
+  RESERVED_VCL_N10,
+  RESERVED_VCL_R11,
+  RESERVED_VCL_N12,
+  RESERVED_VCL_R13,
+  RESERVED_VCL_N14,
+  RESERVED_VCL_R15,
+
+  BLA_W_LP,    // 16
+  BLA_W_RADL,  // 17
+  BLA_N_LP,    // 18
+  IDR_W_RADL,  // 19
+  IDR_N_LP,    // 20
+  CRA,         // 21
+  RESERVED_IRAP_VCL22,
+  RESERVED_IRAP_VCL23,
+
+  RESERVED_VCL24,
+  RESERVED_VCL25,
+  RESERVED_VCL26,
+  RESERVED_VCL27,
+  RESERVED_VCL28,
+  RESERVED_VCL29,
+  RESERVED_VCL30,
+  RESERVED_VCL31,
+
+  VPS,                     // 32
+  SPS,                     // 33
+  PPS,                     // 34
+  ACCESS_UNIT_DELIMITER,   // 35
+  EOS,                     // 36
+  EOB,                     // 37
+  FILLER_DATA,             // 38
+  PREFIX_SEI,              // 39
+  SUFFIX_SEI,              // 40
+
+  RESERVED_NVCL41,
+  RESERVED_NVCL42,
+  RESERVED_NVCL43,
+  RESERVED_NVCL44,
+  RESERVED_NVCL45,
+  RESERVED_NVCL46,
+  RESERVED_NVCL47,
+  UNSPECIFIED_48,
+  UNSPECIFIED_49,
+  UNSPECIFIED_50,
+  UNSPECIFIED_51,
+  UNSPECIFIED_52,
+  UNSPECIFIED_53,
+  UNSPECIFIED_54,
+  UNSPECIFIED_55,
+  UNSPECIFIED_56,
+  UNSPECIFIED_57,
+  UNSPECIFIED_58,
+  UNSPECIFIED_59,
+  UNSPECIFIED_60,
+  UNSPECIFIED_61,
+  UNSPECIFIED_62,
+  UNSPECIFIED_63,
+  INVALID,
+};
+
+static const bool verbose = false;
+
+/**
+ Read-only view of an input segment. On POSIX systems the file is mapped into memory, so that
+ untouched NAL unit payloads can be passed to the output without ever being copied.
+ */
+class InputFile
+{
+public:
+  InputFile() : m_data(NULL), m_size(0), m_mapped(false) {}
+  ~InputFile() { close(); }
+
+  bool open(const char * path)
+  {
+#if PARCAT_USE_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+      ::close(fd);
+      return false;
+    }
+    m_size = (size_t) st.st_size;
+    if (m_size > 0)
+    {
+      void * map = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED)
+      {
+        madvise(map, m_size, MADV_SEQUENTIAL);
+        m_data   = (const uint8_t *) map;
+        m_mapped = true;
+        ::close(fd);
+        return true;
+      }
+    }
+    ::close(fd);
+#endif
+    // fall back to reading the whole file
+    FILE * fdi = fopen(path, "rb");
+    if (fdi == NULL)
+    {
+      return false;
+    }
+    fseek(fdi, 0, SEEK_END);
+    long long full_sz = ftell(fdi);
+    fseek(fdi, 0, SEEK_SET);
+
+    m_buf.resize((size_t) std::max(full_sz, 0LL));
+    size_t sz = fread((char*) m_buf.data(), 1, m_buf.size(), fdi);
+    fclose(fdi);
+
+    if (sz != m_buf.size())
+    {
+      fprintf(stderr, "Error: input file was not read completely.");
+      exit(1);
+    }
+    m_data = m_buf.data();
+    m_size = m_buf.size();
+    return true;
+  }
+
+  void close()
+  {
+#if PARCAT_USE_MMAP
+    if (m_mapped)
+    {
+      munmap((void *) m_data, m_size);
+    }
+#endif
+    m_buf.clear();
+    m_data   = NULL;
+    m_size   = 0;
+    m_mapped = false;
+  }
+
+  const uint8_t * data() const { return m_data; }
+  size_t          size() const { return m_size; }
+
+private:
+  InputFile(const InputFile &);
+  InputFile & operator=(const InputFile &);
+
+  const uint8_t *      m_data;
+  size_t               m_size;
+  bool                 m_mapped;
+  std::vector<uint8_t> m_buf;
+};
+
+/**
+ Gathering output writer. Byte ranges are queued by reference and written with as few system calls as
+ possible (writev on POSIX systems), the referenced memory has to stay valid until flush() returns.
+ */
+class OutputWriter
+{
+public:
+  OutputWriter() : m_fdo(NULL) {}
+  ~OutputWriter() { close(); }
+
+  bool open(const char * path)
+  {
+    m_fdo = fopen(path, "wb");
+    return m_fdo != NULL;
+  }
+
+  void close()
+  {
+    if (m_fdo)
+    {
+      flush();
+      fclose(m_fdo);
+      m_fdo = NULL;
+    }
+  }
+
+  void add(const uint8_t * data, size_t size)
+  {
+    if (size == 0)
+    {
+      return;
+    }
+    // merge with the preceding range if contiguous in memory
+    if (!m_chunks.empty() && m_chunks.back().data + m_chunks.back().size == data)
+    {
+      m_chunks.back().size += size;
+    }
+    else
+    {
+      Chunk chunk = { data, size };
+      m_chunks.push_back(chunk);
+    }
+  }
+
+  void flush()
+  {
+#if PARCAT_USE_MMAP
+    fflush(m_fdo);
+    const int fd = fileno(m_fdo);
+    std::vector<struct iovec> iov;
+    for (size_t i = 0; i < m_chunks.size(); )
+    {
+      const size_t num = std::min<size_t>(m_chunks.size() - i, IOV_MAX);
+      iov.resize(num);
+      for (size_t j = 0; j < num; j++)
+      {
+        iov[j].iov_base = (void *) m_chunks[i + j].data;
+        iov[j].iov_len  = m_chunks[i + j].size;
+      }
+      struct iovec * cur = iov.data();
+      size_t         cnt = num;
+      while (cnt > 0)
+      {
+        ssize_t written = writev(fd, cur, (int) cnt);
+        if (written < 0)
+        {
+          fprintf(stderr, "Error: could not write output file.");
+          exit(1);
+        }
+        // skip what has been written, a partial write may end inside a range
+        while (cnt > 0 && (size_t) written >= cur->iov_len)
+        {
+          written -= cur->iov_len;
+          cur++;
+          cnt--;
+        }
+        if (cnt > 0)
+        {
+          cur->iov_base = (uint8_t *) cur->iov_base + written;
+          cur->iov_len -= written;
+        }
+      }
+      i += num;
+    }
+#else
+    for (size_t i = 0; i < m_chunks.size(); i++)
+    {
+      if (fwrite(m_chunks[i].data, 1, m_chunks[i].size, m_fdo) != m_chunks[i].size)
+      {
+        fprintf(stderr, "Error: could not write output file.");
+        exit(1);
+      }
+    }
+#endif
+    m_chunks.clear();
+  }
+
+private:
+  struct Chunk
+  {
+    const uint8_t * data;
+    size_t          size;
+  };
+
+  FILE *             m_fdo;
+  std::vector<Chunk> m_chunks;
+};
+
+/**
+ Find the next start code prefix (0x000001) or, if zero_stop is set, the next 0x000000 sequence, at or
+ after pos. The zero bytes are located with memchr, which the C library implements with vector instructions.
+ @return the offset of the first byte of the sequence, or size if there is none
+ */
+static size_t find_start_code(const uint8_t * buf, size_t pos, size_t size, bool zero_stop)
+{
+  while (pos + 2 < size)
+  {
+    const uint8_t * z = (const uint8_t *) memchr(buf + pos, 0, size - pos - 2);
+    if (z == NULL)
+    {
+      break;
+    }
+    pos = z - buf;
+    if (buf[pos + 1] != 0)
+    {
+      pos += 2;
+      continue;
+    }
+    if (buf[pos + 2] == 1 || (zero_stop && buf[pos + 2] == 0))
+    {
+      return pos;
+    }
+    pos++;
+  }
+  return size;
+}
+
+struct SegmentNal
+{
+  size_t   prefix;       // offset of the bytes preceding the NAL unit (zero bytes and start code)
+  size_t   start;        // offset of the NAL unit header
+  size_t   end;          // offset past the last byte of the NAL unit
+  size_t   poc_offset;   // offset of the two bytes containing slice_pic_order_cnt_lsb, 0 if none
+  uint16_t poc_data;     // original value of these two bytes
+  int      poc_low_bits; // number of bits below slice_pic_order_cnt_lsb in poc_data
+  int      poc;          // POC relative to the segment
+};
+
+struct Segment
+{
+  InputFile               file;
+  std::vector<SegmentNal> nalus;   // NAL units to be written
+  int                     poc_cnt; // number of pictures, which is the POC offset of the following segment
+};
+
+/**
+ Locate the NAL units of a segment, drop the ones which are not needed in the concatenated stream and
+ determine where the POC has to be rewritten. The segment data itself is not modified.
+ */
+static void scan_segment(Segment & seg, int idx)
+{
+  const uint8_t * buf = seg.file.data();
+  const size_t    sz  = seg.file.size();
+  size_t          pos = 0;
+  int             cnt = 0;
+  bool idr_found      = false;
+  bool skip_next_sei  = false;
+
+  const int bits_for_poc = 8;
+
+  while (true)
+  {
+    size_t sc = find_start_code(buf, pos, sz, false);
+    if (sc + 3 >= sz)
+    {
+      break;
+    }
+    SegmentNal nal;
+    nal.prefix       = pos;
+    nal.start        = sc + 3;
+    // as before, a start code in the last three bytes does not terminate the NAL unit
+    nal.end          = find_start_code(buf, nal.start, sz - 1, true);
+    nal.end          = nal.end == sz - 1 ? sz : nal.end;
+    if (nal.end == nal.start)
+    {
+      break;
+    }
+    nal.poc_offset   = 0;
+    nal.poc_data     = 0;
+    nal.poc_low_bits = 0;
+    nal.poc          = -1;
+
+    if(verbose)
+    {
+       printf( "!! Found NAL at offset %lld (0x%04llX), size %lld (0x%04llX) \n",
+          (long long int)nal.prefix,
+          (long long int)nal.prefix,
+          (long long int)(nal.end - nal.start),
+          (long long int)(nal.end - nal.start) );
+    }
+
+    const uint8_t * nalu      = buf + nal.start;
+    const size_t    nalu_size = nal.end - nal.start;
+    int nalu_type = nalu[0] >> 1;
+
+    if(nalu_type == IDR_W_RADL || nalu_type == IDR_N_LP)
+    {
+      nal.poc = 0;
+    }
+
+    if(nalu_type < 32 && nalu_type != IDR_W_RADL && nalu_type != IDR_N_LP)
+    {
+      int offset = 16;
+
+      offset += 1; //first_slice_segment_in_pic_flag
+      if (nalu_type >= BLA_W_LP && nalu_type <= RESERVED_IRAP_VCL23)
+      {
+        offset += 1; //no_output_of_prior_pics_flag
+      }
+
+      // determine offset for slice_pic_parameter_set_id TODO: ue(v)
+      int byte_offset2 = offset / 8;
+      int hi_bits2 = offset % 8;
+      uint16_t data2 = (nalu[byte_offset2] << 8) | nalu[byte_offset2 + 1];
+      int low_bits2 = 16 - hi_bits2 - 1;
+      if(((data2 >> low_bits2) % 2))
+        offset += 1; // PPSId=0
+      else
+        offset += 3; // PPSId=1
+      offset += 1; // slice_type TODO: ue(v)
+      // separate_colour_plane_flag is not supported in JEM1.0
+      if (nalu_type == CRA)
+      {
+        offset += 2;
+      }
+      int byte_offset = offset / 8;
+      int hi_bits = offset % 8;
+      if (byte_offset + 1 < (int) nalu_size)
+      {
+        uint16_t data = (nalu[byte_offset] << 8) | nalu[byte_offset + 1];
+        int low_bits = 16 - hi_bits - bits_for_poc;
+
+        nal.poc          = (data >> low_bits) & 0xff;
+        nal.poc_offset   = nal.start + byte_offset;
+        nal.poc_data     = data;
+        nal.poc_low_bits = low_bits;
+      }
+
+      ++cnt;
+    }
+
+    if(idx > 1 && (nalu_type == IDR_W_RADL || nalu_type == IDR_N_LP))
+    {
+      skip_next_sei = true;
+      idr_found = true;
+    }
+
+    if((idx > 1 && (nalu_type == IDR_W_RADL || nalu_type == IDR_N_LP )) || ((idx>1 && !idr_found) && ( nalu_type == VPS || nalu_type == SPS || nalu_type == PPS))
+      || (nalu_type == SUFFIX_SEI && skip_next_sei))
+    {
+    }
+    else
+    {
+      seg.nalus.push_back(nal);
+    }
+
+    if(nalu_type == SUFFIX_SEI && skip_next_sei)
+    {
+      skip_next_sei = false;
+    }
+
+    pos = nal.end;
+  }
+
+  seg.poc_cnt = cnt;
+}
+
+/**
+ Queue the retained NAL units of a segment for output. Only the two bytes carrying the POC LSBs of
+ each slice header are rewritten (into patches), everything else is referenced in the input.
+ */
+static void write_segment(const Segment & seg, int poc_base, int last_idr_poc, OutputWriter & out, std::deque<std::array<uint8_t, 2> > & patches)
+{
+  const uint8_t * buf = seg.file.data();
+  const int bits_for_poc = 8;
+
+  for (size_t i = 0; i < seg.nalus.size(); i++)
+  {
+    const SegmentNal & nal = seg.nalus[i];
+
+    if (nal.poc_offset == 0)
+    {
+      out.add(buf + nal.prefix, nal.end - nal.prefix);
+      continue;
+    }
+
+    int new_poc = nal.poc + poc_base;
+    // Int picOrderCntLSB = (pcSlice->getPOC()-pcSlice->getLastIDR()+(1<<pcSlice->getSPS()->getBitsForPOC())) & ((1<<pcSlice->getSPS()->getBitsForPOC())-1);
+    unsigned picOrderCntLSB = (new_poc - last_idr_poc +(1 << bits_for_poc)) & ((1<<bits_for_poc)-1);
+
+    const int hi_bits  = 16 - bits_for_poc - nal.poc_low_bits;
+    const int low_bits = nal.poc_low_bits;
+    int low = nal.poc_data & ((1 << (low_bits + 1)) - 1);
+    int hi = nal.poc_data >> (16 - hi_bits);
+    uint16_t data = (hi << (16 - hi_bits)) | (picOrderCntLSB << low_bits) | low;
+
+    patches.push_back(std::array<uint8_t, 2>());
+    std::array<uint8_t, 2> & patch = patches.back();
+    patch[0] = data >> 8;
+    patch[1] = data & 0xff;
+
+    out.add(buf + nal.prefix, nal.poc_offset - nal.prefix);
+    out.add(patch.data(), 2);
+    out.add(buf + nal.poc_offset + 2, nal.end - nal.poc_offset - 2);
+  }
+}
+
+bool concatenate(const std::vector<std::string> & inputs, const std::string & output)
+{
+  OutputWriter out;
+  if (!out.open(output.c_str()))
+  {
+    fprintf(stderr, "Error: could not open output file: %s", output.c_str());
+    return false;
+  }
+
+  const int num_segments = (int) inputs.size();
+  std::vector<Segment> segments(num_segments);
+
+  for(int i = 0; i < num_segments; ++i)
+  {
+    if (!segments[i].file.open(inputs[i].c_str()))
+    {
+      fprintf(stderr, "Error: could not open input file: %s", inputs[i].c_str());
+      return false;
+    }
+  }
+
+  // the segments are scanned independently, only the POC offsets depend on the preceding segments
+  std::atomic<int> next_segment(0);
+  auto scan_worker = [&]()
+  {
+    for (int i = next_segment++; i < num_segments; i = next_segment++)
+    {
+      scan_segment(segments[i], i + 1);
+    }
+  };
+
+  const int num_threads = std::max(1, std::min<int>(num_segments, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_threads; t++)
+  {
+    threads.push_back(std::thread(scan_worker));
+  }
+  scan_worker();
+  for (size_t t = 0; t < threads.size(); t++)
+  {
+    threads[t].join();
+  }
+
+  int poc_base = 0;
+  int last_idr_poc = 0;
+
+  for(int i = 0; i < num_segments; ++i)
+  {
+    std::deque<std::array<uint8_t, 2> > patches;
+    write_segment(segments[i], poc_base, last_idr_poc, out, patches);
+    out.flush();
+    segments[i].file.close();
+
+    poc_base += segments[i].poc_cnt;
+  }
+
+  out.close();
+  return true;
+}
+
+} // namespace parcat